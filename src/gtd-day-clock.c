@@ -0,0 +1,302 @@
+/* gtd-day-clock.c
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtd-day-clock.h"
+
+#include <gio/gio.h>
+#include <glib/gi18n.h>
+
+typedef struct
+{
+  /* julian day number of today */
+  guint32                today;
+
+  /* julian day → formatted label */
+  GHashTable            *labels;
+
+  guint                  timeout_id;
+  GFileMonitor          *timezone_monitor;
+} GtdDayClockPrivate;
+
+struct _GtdDayClock
+{
+  GObject             parent;
+
+  /*<private>*/
+  GtdDayClockPrivate *priv;
+};
+
+/*
+ * The clock wakes up at local midnight, but at least once an hour
+ * so that suspends and clock changes are noticed too.
+ */
+#define MAX_WAIT_SECONDS 3600
+
+G_DEFINE_TYPE_WITH_PRIVATE (GtdDayClock, gtd_day_clock, G_TYPE_OBJECT)
+
+enum {
+  DAY_CHANGED,
+  NUM_SIGNALS
+};
+
+static guint signals[NUM_SIGNALS] = { 0, };
+
+static void          gtd_day_clock__schedule_update              (GtdDayClock        *clock);
+
+static guint32
+gtd_day_clock__get_julian_day (GDateTime *dt)
+{
+  GDate date;
+  gint year;
+  gint month;
+  gint day;
+
+  g_date_time_get_ymd (dt, &year, &month, &day);
+
+  g_date_clear (&date, 1);
+  g_date_set_dmy (&date, day, month, year);
+
+  return g_date_get_julian (&date);
+}
+
+static void
+gtd_day_clock__update_today (GtdDayClock *clock)
+{
+  GtdDayClockPrivate *priv = clock->priv;
+  GDateTime *now;
+  guint32 today;
+
+  now = g_date_time_new_now_local ();
+  today = gtd_day_clock__get_julian_day (now);
+
+  g_date_time_unref (now);
+
+  if (priv->today == today)
+    return;
+
+  g_debug ("%s: day changed", G_STRFUNC);
+
+  /* The labels are relative to today, so they're all stale now */
+  priv->today = today;
+  g_hash_table_remove_all (priv->labels);
+
+  g_signal_emit (clock, signals[DAY_CHANGED], 0);
+}
+
+static gboolean
+gtd_day_clock__timeout_cb (GtdDayClock *clock)
+{
+  clock->priv->timeout_id = 0;
+
+  gtd_day_clock__update_today (clock);
+  gtd_day_clock__schedule_update (clock);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtd_day_clock__schedule_update (GtdDayClock *clock)
+{
+  GDateTime *now;
+  GDateTime *midnight;
+  GDateTime *tomorrow;
+  GTimeSpan span;
+
+  now = g_date_time_new_now_local ();
+  midnight = g_date_time_new_local (g_date_time_get_year (now),
+                                    g_date_time_get_month (now),
+                                    g_date_time_get_day_of_month (now),
+                                    0, 0, 0);
+  tomorrow = g_date_time_add_days (midnight, 1);
+
+  span = g_date_time_difference (tomorrow, now) / G_TIME_SPAN_SECOND + 1;
+
+  clock->priv->timeout_id = g_timeout_add_seconds (MIN (span, MAX_WAIT_SECONDS),
+                                                   (GSourceFunc) gtd_day_clock__timeout_cb,
+                                                   clock);
+
+  g_date_time_unref (tomorrow);
+  g_date_time_unref (midnight);
+  g_date_time_unref (now);
+}
+
+static void
+gtd_day_clock__timezone_changed (GFileMonitor      *monitor,
+                                 GFile             *file,
+                                 GFile             *other_file,
+                                 GFileMonitorEvent  event,
+                                 gpointer           user_data)
+{
+  GtdDayClock *clock = GTD_DAY_CLOCK (user_data);
+
+  if (clock->priv->timeout_id > 0)
+    g_source_remove (clock->priv->timeout_id);
+
+  gtd_day_clock__update_today (clock);
+  gtd_day_clock__schedule_update (clock);
+}
+
+static void
+gtd_day_clock_finalize (GObject *object)
+{
+  GtdDayClock *self = (GtdDayClock *)object;
+  GtdDayClockPrivate *priv = gtd_day_clock_get_instance_private (self);
+
+  if (priv->timeout_id > 0)
+    g_source_remove (priv->timeout_id);
+
+  g_clear_object (&priv->timezone_monitor);
+  g_clear_pointer (&priv->labels, g_hash_table_destroy);
+
+  G_OBJECT_CLASS (gtd_day_clock_parent_class)->finalize (object);
+}
+
+static void
+gtd_day_clock_class_init (GtdDayClockClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = gtd_day_clock_finalize;
+
+  /**
+   * GtdDayClock::day-changed:
+   *
+   * The ::day-changed signal is emmited when the local day changes,
+   * either at midnight or because the timezone changed.
+   */
+  signals[DAY_CHANGED] = g_signal_new ("day-changed",
+                                       GTD_TYPE_DAY_CLOCK,
+                                       G_SIGNAL_RUN_LAST,
+                                       0,
+                                       NULL,
+                                       NULL,
+                                       NULL,
+                                       G_TYPE_NONE,
+                                       0);
+}
+
+static void
+gtd_day_clock_init (GtdDayClock *self)
+{
+  GFile *localtime;
+
+  self->priv = gtd_day_clock_get_instance_private (self);
+  self->priv->labels = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+
+  /* Follow timezone changes */
+  localtime = g_file_new_for_path ("/etc/localtime");
+  self->priv->timezone_monitor = g_file_monitor_file (localtime, G_FILE_MONITOR_NONE, NULL, NULL);
+
+  if (self->priv->timezone_monitor)
+    {
+      g_signal_connect (self->priv->timezone_monitor,
+                        "changed",
+                        G_CALLBACK (gtd_day_clock__timezone_changed),
+                        self);
+    }
+
+  g_object_unref (localtime);
+
+  gtd_day_clock__update_today (self);
+  gtd_day_clock__schedule_update (self);
+}
+
+/**
+ * gtd_day_clock_get_default:
+ *
+ * Retrieves the #GtdDayClock shared by the whole application.
+ *
+ * Returns: (transfer none): the default #GtdDayClock
+ */
+GtdDayClock*
+gtd_day_clock_get_default (void)
+{
+  static GtdDayClock *clock = NULL;
+
+  if (!clock)
+    clock = g_object_new (GTD_TYPE_DAY_CLOCK, NULL);
+
+  return clock;
+}
+
+/**
+ * gtd_day_clock_get_today:
+ * @clock: a #GtdDayClock
+ *
+ * Retrieves the julian day number of the current local day.
+ *
+ * Returns: the julian day of today
+ */
+guint32
+gtd_day_clock_get_today (GtdDayClock *clock)
+{
+  g_return_val_if_fail (GTD_IS_DAY_CLOCK (clock), 0);
+
+  return clock->priv->today;
+}
+
+/**
+ * gtd_day_clock_format_date:
+ * @clock: a #GtdDayClock
+ * @date: (nullable): a #GDateTime
+ *
+ * Formats @date relative to today, e.g. "Today", "Tomorrow" or the
+ * name of the weekday. Labels are cached per day until the day
+ * changes.
+ *
+ * Returns: (transfer none): the label of @date. Do not free.
+ */
+const gchar*
+gtd_day_clock_format_date (GtdDayClock *clock,
+                           GDateTime   *date)
+{
+  GtdDayClockPrivate *priv;
+  gchar *label;
+  guint32 day;
+  gint64 offset;
+
+  g_return_val_if_fail (GTD_IS_DAY_CLOCK (clock), NULL);
+
+  priv = clock->priv;
+
+  if (!date)
+    return _("No date set");
+
+  day = gtd_day_clock__get_julian_day (date);
+  label = g_hash_table_lookup (priv->labels, GUINT_TO_POINTER (day));
+
+  if (label)
+    return label;
+
+  offset = (gint64) day - priv->today;
+
+  if (offset == 0)
+    label = g_strdup (_("Today"));
+  else if (offset == 1)
+    label = g_strdup (_("Tomorrow"));
+  else if (offset == -1)
+    label = g_strdup (_("Yesterday"));
+  else if (offset > 1 && offset < 7)
+    label = g_date_time_format (date, "%A");
+  else
+    label = g_date_time_format (date, "%x");
+
+  g_hash_table_insert (priv->labels, GUINT_TO_POINTER (day), label);
+
+  return label;
+}
@@ -0,0 +1,41 @@
+/* gtd-day-clock.h
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GTD_DAY_CLOCK_H
+#define GTD_DAY_CLOCK_H
+
+#include "gtd-types.h"
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define GTD_TYPE_DAY_CLOCK (gtd_day_clock_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdDayClock, gtd_day_clock, GTD, DAY_CLOCK, GObject)
+
+GtdDayClock*              gtd_day_clock_get_default             (void);
+
+guint32                   gtd_day_clock_get_today               (GtdDayClock         *clock);
+
+const gchar*              gtd_day_clock_format_date             (GtdDayClock         *clock,
+                                                                 GDateTime           *date);
+
+G_END_DECLS
+
+#endif /* GTD_DAY_CLOCK_H */
@@ -0,0 +1,164 @@
+/* gtd-fractional-index.c
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtd-fractional-index.h"
+
+#include <string.h>
+
+/*
+ * Fractional indices are the digits of a number between 0 and 1
+ * in base 62. The digits are in ASCII order, so the keys sort
+ * with a plain strcmp(), and a key never ends with a zero, so
+ * there's always room for a new key between any two of them.
+ */
+#define DIGITS "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define BASE   62
+
+static gint
+gtd_fractional_index__digit_value (gchar digit)
+{
+  const gchar *p = strchr (DIGITS, digit);
+
+  return digit && p ? p - DIGITS : 0;
+}
+
+/*
+ * Appends to @key the digits of a fraction between @a and @b. @a
+ * may be empty, which stands for 0, and @b may be %NULL, which
+ * stands for 1.
+ */
+static void
+gtd_fractional_index__append_midpoint (GString     *key,
+                                       const gchar *a,
+                                       const gchar *b)
+{
+  gint digit_a;
+  gint digit_b;
+
+  if (b)
+    {
+      /* Copy the common prefix, padding @a with zeros */
+      while (*b && (*a ? *a : '0') == *b)
+        {
+          g_string_append_c (key, *b);
+
+          a = *a ? a + 1 : a;
+          b++;
+        }
+    }
+
+  digit_a = gtd_fractional_index__digit_value (*a);
+  digit_b = b ? gtd_fractional_index__digit_value (*b) : BASE;
+
+  if (digit_b - digit_a > 1)
+    {
+      g_string_append_c (key, DIGITS[(digit_a + digit_b) / 2]);
+    }
+  else if (b && b[1])
+    {
+      /* @b has more digits, so its first digit alone is in between */
+      g_string_append_c (key, *b);
+    }
+  else
+    {
+      g_string_append_c (key, DIGITS[digit_a]);
+      gtd_fractional_index__append_midpoint (key, *a ? a + 1 : a, NULL);
+    }
+}
+
+/**
+ * gtd_fractional_index_between:
+ * @before: (nullable): the key to sort after, or %NULL
+ * @after: (nullable): the key to sort before, or %NULL
+ *
+ * Creates a key that sorts between @before and @after. If @before
+ * is %NULL, the key sorts before @after, and if @after is %NULL,
+ * the key sorts after @before. The keys only grow longer when
+ * there's no room left between them.
+ *
+ * Returns: (transfer full): a newly allocated key. Free with @g_free.
+ */
+gchar*
+gtd_fractional_index_between (const gchar *before,
+                              const gchar *after)
+{
+  GString *key;
+
+  g_return_val_if_fail (!before || !after || g_strcmp0 (before, after) < 0, NULL);
+
+  key = g_string_new ("");
+
+  gtd_fractional_index__append_midpoint (key, before ? before : "", after);
+
+  return g_string_free (key, FALSE);
+}
+
+/**
+ * gtd_fractional_index_spread:
+ * @n_keys: the number of keys
+ *
+ * Creates @n_keys sorted keys, evenly spread and as short as
+ * possible. This is used to rebalance keys that grew too long.
+ *
+ * Returns: (transfer full): a %NULL-terminated array of keys. Free
+ * with @g_strfreev.
+ */
+gchar**
+gtd_fractional_index_spread (guint n_keys)
+{
+  guint64 range;
+  gchar **keys;
+  guint n_digits;
+  guint i;
+
+  range = BASE;
+  n_digits = 1;
+
+  while (range <= n_keys)
+    {
+      range *= BASE;
+      n_digits++;
+    }
+
+  keys = g_new0 (gchar*, n_keys + 1);
+
+  for (i = 0; i < n_keys; i++)
+    {
+      guint64 value;
+      gchar *key;
+      guint length;
+      guint j;
+
+      value = (i + 1) * range / (n_keys + 1);
+      key = g_malloc0 (n_digits + 1);
+
+      for (j = n_digits; j > 0; j--)
+        {
+          key[j - 1] = DIGITS[value % BASE];
+          value /= BASE;
+        }
+
+      /* Trailing zeros don't change the value, and keys never end with one */
+      for (length = n_digits; length > 1 && key[length - 1] == '0'; length--)
+        key[length - 1] = '\0';
+
+      keys[i] = key;
+    }
+
+  return keys;
+}
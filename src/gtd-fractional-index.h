@@ -0,0 +1,33 @@
+/* gtd-fractional-index.h
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GTD_FRACTIONAL_INDEX_H
+#define GTD_FRACTIONAL_INDEX_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+gchar*                    gtd_fractional_index_between          (const gchar         *before,
+                                                                 const gchar         *after);
+
+gchar**                   gtd_fractional_index_spread           (guint                n_keys);
+
+G_END_DECLS
+
+#endif /* GTD_FRACTIONAL_INDEX_H */
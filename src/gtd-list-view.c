@@ -18,9 +18,11 @@
 
 #include "gtd-arrow-frame.h"
 #include "gtd-edit-pane.h"
+#include "gtd-fractional-index.h"
 #include "gtd-list-view.h"
 #include "gtd-manager.h"
 #include "gtd-task.h"
+#include "gtd-task-aggregate.h"
 #include "gtd-task-list.h"
 #include "gtd-task-row.h"
 #include "gtd-window.h"
@@ -28,6 +30,7 @@
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <gtk/gtk.h>
+#include <string.h>
 
 typedef struct
 {
@@ -39,20 +42,66 @@ typedef struct
   GtkRevealer           *revealer;
   GtkImage              *done_image;
   GtkLabel              *done_label;
-  GtkScrolledWindow     *viewport;
+  GtkViewport           *viewport;
+
+  /* selection mode widgets */
+  GtkMenuButton         *date_button;
+  GtkMenuButton         *move_button;
+  GtkWidget             *selection_bar;
+  GtkCalendar           *selection_calendar;
+  GtkRevealer           *selection_revealer;
 
   /* internal */
-  gboolean               can_toggle;
   gint                   complete_tasks;
+
+  /* tasks of the model, shown or not */
+  guint                  n_tasks;
   gboolean               readonly;
   gboolean               show_list_name;
   gboolean               show_completed;
   GList                 *list;
   GtdTaskList           *task_list;
+  GtdTaskAggregate      *aggregate;
   GtdManager            *manager;
 
-  /* color provider */
-  GtkCssProvider        *color_provider;
+  /* GtdTask → GtdTaskRow of the existing rows */
+  GHashTable            *task_to_row;
+
+  /* tasks waiting for their rows to be created */
+  GQueue                *pending_tasks;
+  guint                  populate_tick_id;
+  gboolean               populate_animated;
+
+  /* model changes waiting for the next frame */
+  GQueue                *task_changes;
+  guint                  changes_tick_id;
+
+  /* selection mode, with the selected tasks as a set */
+  gboolean               selection_mode;
+  GHashTable            *selected_tasks;
+  GSimpleActionGroup    *actions;
+
+  /* manual order, with the task being dragged */
+  gboolean               manual_order;
+  GtdTask               *drag_task;
+  guint                  rebalance_id;
+
+  /* style class of the list color, see gtd_list_view__get_color_class() */
+  gchar                 *color_class;
+
+  /*
+   * Virtual mode: only the rows around the visible area exist,
+   * bound to the sorted tasks in @tasks, and the spacers take
+   * the place of the rows above and below them.
+   */
+  gboolean               virtual_mode;
+  gboolean               tasks_unsorted;
+  GPtrArray             *tasks;
+  GtkWidget             *top_spacer;
+  GtkWidget             *bottom_spacer;
+  guint                  n_virtual_rows;
+  gint                   row_height;
+  guint                  virtual_update_id;
 } GtdListViewPrivate;
 
 struct _GtdListView
@@ -63,40 +112,183 @@ struct _GtdListView
   GtdListViewPrivate *priv;
 };
 
-#define COLOR_TEMPLATE "GtkViewport {background-color: %s;}"
+#define COLOR_TEMPLATE "GtkViewport.%s {background-color: %s;}"
 
 #define TASK_REMOVED_NOTIFICATION_ID             "task-removed-id"
 
+/*
+ * Lists with more visible tasks than VIRTUAL_THRESHOLD only have
+ * rows for the visible tasks, plus VIRTUAL_MARGIN_ROWS above and
+ * below them, and the rows are reused while scrolling.
+ */
+#define VIRTUAL_THRESHOLD                        1000
+#define VIRTUAL_MARGIN_ROWS                      10
+
+/*
+ * When populating, rows are created for at most POPULATE_FRAME_BUDGET
+ * microseconds per frame. The first POPULATE_FIRST_ROWS rows are always
+ * created right away, so the first screenful shows up immediately.
+ */
+#define POPULATE_FRAME_BUDGET                    5000
+#define POPULATE_FIRST_ROWS                      20
+
+/* Inserting or removing more rows than this at once is not animated */
+#define BULK_ANIMATION_THRESHOLD                 10
+
+/*
+ * In manual order, positions that grew longer than MAX_POSITION_LENGTH
+ * are replaced by short, evenly spread ones REBALANCE_DELAY seconds
+ * after the last reorder.
+ */
+#define MAX_POSITION_LENGTH                      6
+#define REBALANCE_DELAY                          30
+
+static const GtkTargetEntry row_targets[] = {
+  { "GTK_LIST_BOX_ROW", GTK_TARGET_SAME_APP, 0 }
+};
+
+/*
+ * The list colors live in a single provider shared by all views,
+ * with a style class per list. It is only regenerated when the
+ * color of a list changes, or a list is removed.
+ */
+typedef struct
+{
+  gchar                 *css_class;
+  gchar                 *color;
+} ListColor;
+
+static GtkCssProvider   *color_provider = NULL;
+static GHashTable       *list_colors = NULL;
+static guint             n_color_classes = 0;
+
 /* prototypes */
 static void             gtd_list_view__task_completed                 (GObject          *object,
                                                                        GParamSpec       *spec,
                                                                        gpointer          user_data);
 
+static void             gtd_list_view__insert_task                    (GtdListView      *view,
+                                                                       GtdTask          *task,
+                                                                       gboolean          animated);
+
+static void             gtd_list_view__reposition_task                (GtdListView      *view,
+                                                                       GtdTask          *task);
+
+static void             gtd_list_view__remove_task                    (GtdListView      *view,
+                                                                       GtdTask          *task,
+                                                                       gboolean          animated);
+
+static void             gtd_list_view__complete_selected              (GSimpleAction    *action,
+                                                                       GVariant         *parameter,
+                                                                       gpointer          user_data);
+
+static void             gtd_list_view__delete_selected                (GSimpleAction    *action,
+                                                                       GVariant         *parameter,
+                                                                       gpointer          user_data);
+
+static void             gtd_list_view__move_selected                  (GSimpleAction    *action,
+                                                                       GVariant         *parameter,
+                                                                       gpointer          user_data);
+
+static void             gtd_list_view__set_selected_priority          (GSimpleAction    *action,
+                                                                       GVariant         *parameter,
+                                                                       gpointer          user_data);
+
 G_DEFINE_TYPE_WITH_PRIVATE (GtdListView, gtd_list_view, GTK_TYPE_OVERLAY)
 
 typedef struct
 {
   GtdListView *view;
-  GtdTask     *task;
+  GList       *tasks;
 } RemoveTaskData;
 
+typedef enum
+{
+  TASK_ADDED,
+  TASK_REMOVED,
+  TASK_COMPLETE_CHANGED
+} TaskChangeType;
+
+typedef struct
+{
+  TaskChangeType  type;
+  GtdTask        *task;
+  gboolean        complete;
+} TaskChange;
+
 enum {
   PROP_0,
   PROP_MANAGER,
+  PROP_MANUAL_ORDER,
   PROP_READONLY,
+  PROP_SELECTION_MODE,
   PROP_SHOW_COMPLETED,
   PROP_SHOW_LIST_NAME,
   LAST_PROP
 };
 
+static const GActionEntry gtd_list_view_entries[] = {
+  { "complete-selected", gtd_list_view__complete_selected },
+  { "delete-selected",   gtd_list_view__delete_selected },
+  { "move-selected",     gtd_list_view__move_selected, "s" },
+  { "set-priority",      gtd_list_view__set_selected_priority, "i" }
+};
+
+/*
+ * Starts a batch on each list of @tasks, so that their listeners
+ * handle the whole bulk operation at once, and GtdManager leaves the
+ * saving to the caller. Returns the lists to be passed to
+ * gtd_list_view__end_bulk_update().
+ */
+static GList*
+gtd_list_view__begin_bulk_update (GList *tasks)
+{
+  GList *lists = NULL;
+  GList *l;
+
+  for (l = tasks; l != NULL; l = l->next)
+    {
+      GtdTaskList *list = gtd_task_get_list (l->data);
+
+      if (g_list_find (lists, list))
+        continue;
+
+      gtd_object_begin_update (GTD_OBJECT (list));
+      lists = g_list_prepend (lists, list);
+    }
+
+  return lists;
+}
+
+static void
+gtd_list_view__end_bulk_update (GList *lists)
+{
+  GList *l;
+
+  for (l = lists; l != NULL; l = l->next)
+    gtd_object_end_update (l->data);
+
+  g_list_free (lists);
+}
+
+static void
+remove_task_data_free (RemoveTaskData *data)
+{
+  g_list_free_full (data->tasks, g_object_unref);
+  g_free (data);
+}
+
 static gboolean
 remove_task_action (RemoveTaskData *data)
 {
   g_return_val_if_fail (data != NULL, G_SOURCE_REMOVE);
 
-  gtd_manager_remove_task (data->view->priv->manager, data->task);
+  gtd_manager_remove_tasks (data->view->priv->manager, data->tasks);
 
-  g_free (data);
+  /* The tasks are gone for good, drop the reference they were created with */
+  g_list_foreach (data->tasks, (GFunc) g_object_unref, NULL);
+
+  remove_task_data_free (data);
 
   return G_SOURCE_REMOVE;
 }
@@ -104,13 +296,19 @@ remove_task_action (RemoveTaskData *data)
 static gboolean
 undo_remove_task_action (RemoveTaskData *data)
 {
-  GtdTaskList *list = gtd_task_get_list (data->task);
+  GList *lists;
+  GList *l;
 
   g_return_val_if_fail (data != NULL, G_SOURCE_REMOVE);
 
-  gtd_task_list_save_task (list, data->task);
+  lists = gtd_list_view__begin_bulk_update (data->tasks);
 
-  g_free (data);
+  for (l = data->tasks; l != NULL; l = l->next)
+    gtd_task_list_save_task (gtd_task_get_list (l->data), l->data);
+
+  gtd_list_view__end_bulk_update (lists);
+
+  remove_task_data_free (data);
 
   return G_SOURCE_REMOVE;
 }
@@ -133,7 +331,7 @@ gtd_list_view__remove_task_cb (GtdEditPane *pane,
 
   data = g_new0 (RemoveTaskData, 1);
   data->view = user_data;
-  data->task = task;
+  data->tasks = g_list_prepend (NULL, g_object_ref (task));
 
   /* Remove the task from the list */
   gtd_task_list_remove_task (gtd_task_get_list (task), task);
@@ -171,59 +369,150 @@ gtd_list_view__edit_task_finished (GtdEditPane *pane,
   gtd_task_save (task);
 
   gtd_manager_update_task (priv->manager, task);
-  gtd_task_list_save_task (priv->task_list, task);
+  gtd_task_list_save_task (gtd_task_get_list (task), task);
 
-  gtk_list_box_invalidate_sort (priv->listbox);
+  gtd_list_view__reposition_task (GTD_LIST_VIEW (user_data), task);
 }
 
 static void
-gtd_list_view__color_changed (GObject    *object,
-                              GParamSpec *spec,
-                              gpointer    user_data)
+gtd_list_view__update_color_provider (void)
 {
-  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
+  GHashTableIter iter;
+  ListColor *list_color;
+  GString *css;
+
+  css = g_string_new ("");
+
+  g_hash_table_iter_init (&iter, list_colors);
+
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &list_color))
+    g_string_append_printf (css, COLOR_TEMPLATE "\n", list_color->css_class, list_color->color);
+
+  g_debug ("setting style for provider: %s", css->str);
+
+  gtk_css_provider_load_from_data (color_provider,
+                                   css->str,
+                                   -1,
+                                   NULL);
+
+  g_string_free (css, TRUE);
+}
+
+/*
+ * Retrieves the style class of @list's color, updating the shared
+ * provider if the color changed since the last call.
+ */
+static const gchar*
+gtd_list_view__get_color_class (GtdTaskList *list)
+{
+  ListColor *list_color;
   GdkRGBA *color;
   gchar *color_str;
-  gchar *parsed_css;
 
-  /* Add the color to provider */
-  color = gtd_task_list_get_color (GTD_TASK_LIST (object));
+  if (!color_provider)
+    {
+      color_provider = gtk_css_provider_new ();
+      list_colors = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+      gtk_style_context_add_provider_for_screen (gdk_screen_get_default (),
+                                                 GTK_STYLE_PROVIDER (color_provider),
+                                                 GTK_STYLE_PROVIDER_PRIORITY_APPLICATION + 2);
+    }
+
+  list_color = g_hash_table_lookup (list_colors, list);
+
+  if (!list_color)
+    {
+      list_color = g_new0 (ListColor, 1);
+      list_color->css_class = g_strdup_printf ("list-color-%u", n_color_classes++);
+
+      g_hash_table_insert (list_colors, list, list_color);
+    }
+
+  color = gtd_task_list_get_color (list);
   color_str = gdk_rgba_to_string (color);
 
-  parsed_css = g_strdup_printf (COLOR_TEMPLATE, color_str);
+  if (g_strcmp0 (list_color->color, color_str) != 0)
+    {
+      g_free (list_color->color);
+      list_color->color = color_str;
 
-  gtk_css_provider_load_from_data (priv->color_provider,
-                                   parsed_css,
-                                   -1,
-                                   NULL);
+      gtd_list_view__update_color_provider ();
+    }
+  else
+    {
+      g_free (color_str);
+    }
 
   gdk_rgba_free (color);
-  g_free (color_str);
+
+  return list_color->css_class;
+}
+
+static void
+gtd_list_view__list_removed (GtdManager  *manager,
+                             GtdTaskList *list,
+                             gpointer     user_data)
+{
+  ListColor *list_color;
+
+  if (!list_colors)
+    return;
+
+  list_color = g_hash_table_lookup (list_colors, list);
+
+  if (!list_color)
+    return;
+
+  /* A new list may be allocated at the same address later */
+  g_hash_table_remove (list_colors, list);
+
+  g_free (list_color->css_class);
+  g_free (list_color->color);
+  g_free (list_color);
+
+  gtd_list_view__update_color_provider ();
+}
+
+static void
+gtd_list_view__color_changed (GObject    *object,
+                              GParamSpec *spec,
+                              gpointer    user_data)
+{
+  /* The class stays the same, only the shared provider changes */
+  gtd_list_view__get_color_class (GTD_TASK_LIST (object));
 }
 
 static void
 gtd_list_view__update_done_label (GtdListView *view)
 {
+  GtdListViewPrivate *priv = view->priv;
   gchar *new_label;
 
   g_return_if_fail (GTD_IS_LIST_VIEW (view));
 
+  /*
+   * The aggregate only fetches the completed tasks of its lists when
+   * they're shown, so until then the count is meaningless, and the
+   * button must be there regardless of it.
+   */
+  if (priv->aggregate && !priv->show_completed)
+    {
+      gtk_label_set_label (priv->done_label, _("Done"));
+      gtk_revealer_set_reveal_child (priv->revealer, TRUE);
+      return;
+    }
+
   new_label = g_strdup_printf ("%s (%d)",
                                _("Done"),
-                               view->priv->complete_tasks);
+                               priv->complete_tasks);
 
-  gtk_label_set_label (view->priv->done_label, new_label);
+  gtk_label_set_label (priv->done_label, new_label);
+  gtk_revealer_set_reveal_child (priv->revealer, priv->complete_tasks > 0);
 
   g_free (new_label);
 }
 
-static gboolean
-can_toggle_show_completed (GtdListView *view)
-{
-  view->priv->can_toggle = TRUE;
-  return G_SOURCE_REMOVE;
-}
-
 static void
 gtd_list_view__done_button_clicked (GtkButton *button,
                                     gpointer   user_data)
@@ -233,219 +522,1677 @@ gtd_list_view__done_button_clicked (GtkButton *button,
 
   g_return_if_fail (GTD_IS_LIST_VIEW (view));
 
-  if (!view->priv->can_toggle)
-    return;
-
-  /*
-   * The can_toggle bitfield is needed because the user
-   * can click mindlessly the Done button, while the row
-   * animations are not finished. While the animation is
-   * running, we ignore other clicks.
-   */
-  view->priv->can_toggle = FALSE;
-
   show_completed = view->priv->show_completed;
 
   gtd_list_view_set_show_completed (view, !show_completed);
+}
 
-  g_timeout_add (205,
-                 (GSourceFunc) can_toggle_show_completed,
-                 user_data);
+static gint
+gtd_list_view__row_rank (GtdListView   *view,
+                         GtkListBoxRow *row)
+{
+  /* top spacer, task rows, bottom spacer and the new task row */
+  if ((GtkWidget*) row == view->priv->top_spacer)
+    return 0;
+  else if ((GtkWidget*) row == view->priv->bottom_spacer)
+    return 2;
+  else if (gtd_task_row_get_new_task_mode (GTD_TASK_ROW (row)))
+    return 3;
+  else
+    return 1;
 }
 
 static gint
-gtd_list_view__listbox_sort_func (GtdTaskRow *row1,
-                                  GtdTaskRow *row2,
-                                  gpointer    user_data)
+gtd_list_view__compare (GtdListView *view,
+                        GtdTask     *t1,
+                        GtdTask     *t2)
 {
-  g_return_val_if_fail (GTD_IS_TASK_ROW (row1), 0);
-  g_return_val_if_fail (GTD_IS_TASK_ROW (row2), 0);
+  if (view->priv->manual_order)
+    return gtd_task_compare_manual (t1, t2);
 
-  if (gtd_task_row_get_new_task_mode (row1))
-    return 1;
-  else if (gtd_task_row_get_new_task_mode (row2))
-    return -1;
-  else
-    return gtd_task_compare (gtd_task_row_get_task (row1), gtd_task_row_get_task (row2));
+  return gtd_task_compare (t1, t2);
 }
 
-static void
-gtd_list_view__clear_list (GtdListView *view)
+static gint
+gtd_list_view__listbox_sort_func (GtkListBoxRow *row1,
+                                  GtkListBoxRow *row2,
+                                  gpointer       user_data)
 {
-  GList *children;
-  GList *l;
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  gint rank1;
+  gint rank2;
 
-  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+  rank1 = gtd_list_view__row_rank (view, row1);
+  rank2 = gtd_list_view__row_rank (view, row2);
 
-  view->priv->complete_tasks = 0;
-  gtd_arrow_frame_set_row (view->priv->arrow_frame, NULL);
+  if (rank1 != rank2)
+    return rank1 - rank2;
+
+  return gtd_list_view__compare (view,
+                                 gtd_task_row_get_task (GTD_TASK_ROW (row1)),
+                                 gtd_task_row_get_task (GTD_TASK_ROW (row2)));
+}
 
-  children = gtk_container_get_children (GTK_CONTAINER (view->priv->listbox));
+static gint
+gtd_list_view__compare_tasks (gconstpointer a,
+                              gconstpointer b,
+                              gpointer      user_data)
+{
+  return gtd_list_view__compare (user_data, *((GtdTask**) a), *((GtdTask**) b));
+}
 
-  for (l = children; l != NULL; l = l->next)
+static void
+gtd_list_view__sort_tasks (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  if (priv->tasks_unsorted)
     {
-      if (l->data != view->priv->new_task_row)
-        {
-          g_signal_handlers_disconnect_by_func (gtd_task_row_get_task (l->data),
-                                                gtd_list_view__task_completed,
-                                                view);
-          gtk_widget_destroy (l->data);
-        }
+      g_ptr_array_sort_with_data (priv->tasks, gtd_list_view__compare_tasks, view);
+      priv->tasks_unsorted = FALSE;
     }
-
-  gtk_revealer_set_reveal_child (view->priv->revealer, FALSE);
-  gtk_revealer_set_reveal_child (view->priv->edit_revealer, FALSE);
-
-  g_list_free (children);
 }
 
 static void
-gtd_list_view__row_activated (GtkListBox *listbox,
-                              GtdTaskRow *row,
-                              gpointer    user_data)
+gtd_list_view__row_drag_begin (GtkWidget      *row,
+                               GdkDragContext *context,
+                               gpointer        user_data)
 {
   GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
+  cairo_surface_t *surface;
+  GtkAllocation allocation;
+  cairo_t *cr;
 
-  if (row == priv->new_task_row)
-    return;
+  /* Rows may be reused while scrolling, so hold the task itself */
+  g_clear_object (&priv->drag_task);
+  priv->drag_task = g_object_ref (gtd_task_row_get_task (GTD_TASK_ROW (row)));
 
-  gtd_edit_pane_set_task (priv->edit_pane, gtd_task_row_get_task (row));
+  /* Drag a picture of the row */
+  gtk_widget_get_allocation (row, &allocation);
 
-  gtk_revealer_set_reveal_child (priv->edit_revealer, TRUE);
-  gtd_arrow_frame_set_row (priv->arrow_frame, row);
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, allocation.width, allocation.height);
+  cr = cairo_create (surface);
+
+  gtk_widget_draw (row, cr);
+  gtk_drag_set_icon_surface (context, surface);
+
+  cairo_destroy (cr);
+  cairo_surface_destroy (surface);
 }
 
 static void
-gtd_list_view__add_task (GtdListView *view,
-                         GtdTask     *task)
+gtd_list_view__row_drag_data_get (GtkWidget        *row,
+                                  GdkDragContext   *context,
+                                  GtkSelectionData *selection_data,
+                                  guint             info,
+                                  guint             time,
+                                  gpointer          user_data)
 {
-  GtdListViewPrivate *priv = view->priv;
-  GtkWidget *new_row;
+  gtk_selection_data_set (selection_data,
+                          gdk_atom_intern_static_string ("GTK_LIST_BOX_ROW"),
+                          32,
+                          (const guchar*) &row,
+                          sizeof (gpointer));
+}
 
-  g_return_if_fail (GTD_IS_LIST_VIEW (view));
-  g_return_if_fail (GTD_IS_TASK (task));
+static void
+gtd_list_view__row_drag_end (GtkWidget      *row,
+                             GdkDragContext *context,
+                             gpointer        user_data)
+{
+  g_clear_object (&GTD_LIST_VIEW (user_data)->priv->drag_task);
+}
 
-  new_row = gtd_task_row_new (task);
+static GtkWidget*
+gtd_list_view__create_row (GtdListView *view,
+                           GtdTask     *task)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GtkWidget *row;
 
-  if (!gtd_task_get_complete (task))
+  row = gtd_task_row_new (task);
+  gtd_task_row_set_list_name_visible (GTD_TASK_ROW (row), priv->show_list_name);
+
+  /* Rows of a task list can be dragged to order it manually */
+  if (priv->task_list)
     {
-      gtk_list_box_insert (priv->listbox,
-                           new_row,
-                           0);
-      gtd_task_row_reveal (GTD_TASK_ROW (new_row));
+      gtk_drag_source_set (row,
+                           GDK_BUTTON1_MASK,
+                           row_targets,
+                           G_N_ELEMENTS (row_targets),
+                           GDK_ACTION_MOVE);
+
+      g_signal_connect (row,
+                        "drag-begin",
+                        G_CALLBACK (gtd_list_view__row_drag_begin),
+                        view);
+      g_signal_connect (row,
+                        "drag-data-get",
+                        G_CALLBACK (gtd_list_view__row_drag_data_get),
+                        view);
+      g_signal_connect (row,
+                        "drag-end",
+                        G_CALLBACK (gtd_list_view__row_drag_end),
+                        view);
     }
-  else
-    {
-      priv->complete_tasks++;
 
-      gtd_list_view__update_done_label (view);
+  return row;
+}
 
-      if (!gtk_revealer_get_reveal_child (priv->revealer))
-        gtk_revealer_set_reveal_child (priv->revealer, TRUE);
-    }
+static void
+gtd_list_view__update_row_selection (GtdListView *view,
+                                     GtdTaskRow  *row)
+{
+  GtdTask *task = gtd_task_row_get_task (row);
+
+  /*
+   * Rows are reused in virtual mode, so the selection lives in
+   * the view and the rows only reflect it.
+   */
+  if (task && g_hash_table_contains (view->priv->selected_tasks, task))
+    gtk_widget_set_state_flags (GTK_WIDGET (row), GTK_STATE_FLAG_SELECTED, FALSE);
+  else
+    gtk_widget_unset_state_flags (GTK_WIDGET (row), GTK_STATE_FLAG_SELECTED);
 }
 
 static void
-gtd_list_view__remove_task (GtdListView *view,
-                            GtdTask     *task)
+gtd_list_view__selection_changed (GtdListView *view)
+{
+  gtk_widget_set_sensitive (view->priv->selection_bar,
+                            g_hash_table_size (view->priv->selected_tasks) > 0);
+}
+
+static void
+gtd_list_view__unselect_all (GtdListView *view)
 {
   GtdListViewPrivate *priv = view->priv;
-  GList *children;
-  GList *l;
+  GHashTableIter iter;
+  gpointer row;
 
-  g_return_if_fail (GTD_IS_LIST_VIEW (view));
-  g_return_if_fail (GTD_IS_TASK (task));
+  g_hash_table_remove_all (priv->selected_tasks);
 
-  children = gtk_container_get_children (GTK_CONTAINER (priv->listbox));
+  g_hash_table_iter_init (&iter, priv->task_to_row);
 
-  for (l = children; l != NULL; l = l->next)
-    {
-      if (!gtd_task_row_get_new_task_mode (l->data) &&
-          gtd_task_row_get_task (l->data) == task)
-        {
-          gtd_task_row_destroy (l->data);
-        }
-    }
+  while (g_hash_table_iter_next (&iter, NULL, &row))
+    gtd_list_view__update_row_selection (view, row);
 
-  if (children)
-    g_list_free (children);
+  gtd_list_view__selection_changed (view);
 }
 
 static void
-gtd_list_view__task_completed (GObject    *object,
-                               GParamSpec *spec,
-                               gpointer    user_data)
+gtd_list_view__update_virtual_rows (GtdListView *view)
 {
-  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
-  GtdTask *task = GTD_TASK (object);
-  gboolean task_complete;
+  GtdListViewPrivate *priv = view->priv;
+  GtkAdjustment *vadjustment;
+  GtdTask *edited_task;
+  GtdTaskRow *edited_row;
+  gint row_height;
+  gint n_rows;
+  gint first;
+  gint i;
+
+  if (!priv->virtual_mode)
+    return;
 
-  g_return_if_fail (GTD_IS_TASK (object));
-  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
+  gtd_list_view__sort_tasks (view);
 
-  task_complete = gtd_task_get_complete (task);
+  vadjustment = gtk_scrollable_get_vadjustment (GTK_SCROLLABLE (priv->viewport));
+  row_height = MAX (priv->row_height, 1);
 
-  gtd_manager_update_task (priv->manager, task);
-  gtd_task_list_save_task (gtd_task_get_list (task), task);
+  /* Rows for the visible area, plus a margin above and below it */
+  n_rows = gtk_adjustment_get_page_size (vadjustment) / row_height + 2 * VIRTUAL_MARGIN_ROWS;
+  first = gtk_adjustment_get_value (vadjustment) / row_height - VIRTUAL_MARGIN_ROWS;
 
-  if (task_complete)
-    priv->complete_tasks++;
-  else
-    priv->complete_tasks--;
+  n_rows = MIN (n_rows, (gint) priv->tasks->len);
+  first = CLAMP (first, 0, (gint) priv->tasks->len - n_rows);
+
+  /* Grow or shrink the pool of rows */
+  while ((gint) priv->n_virtual_rows < n_rows)
+    {
+      GtkWidget *row;
+
+      row = gtd_list_view__create_row (view, g_ptr_array_index (priv->tasks, first + priv->n_virtual_rows));
+
+      gtd_task_row_reveal (GTD_TASK_ROW (row), FALSE);
+
+      gtk_list_box_insert (priv->listbox, row, -1);
+
+      priv->n_virtual_rows++;
+    }
+
+  while ((gint) priv->n_virtual_rows > n_rows)
+    {
+      /* The top spacer is at index 0, so the last row is at n_virtual_rows */
+      gtk_widget_destroy (GTK_WIDGET (gtk_list_box_get_row_at_index (priv->listbox, priv->n_virtual_rows)));
+
+      priv->n_virtual_rows--;
+    }
+
+  /* Bind the rows to the tasks, following the listbox order */
+  g_hash_table_remove_all (priv->task_to_row);
+
+  for (i = 0; i < n_rows; i++)
+    {
+      GtdTaskRow *row;
+      GtdTask *task;
+
+      row = GTD_TASK_ROW (gtk_list_box_get_row_at_index (priv->listbox, i + 1));
+      task = g_ptr_array_index (priv->tasks, first + i);
+
+      /* Rows that keep their task are left untouched */
+      if (gtd_task_row_get_task (row) != task)
+        gtd_task_row_set_task (row, task);
+
+      g_hash_table_insert (priv->task_to_row, task, row);
+
+      gtd_list_view__update_row_selection (view, row);
+    }
+
+  /* Keep the edit pane's arrow pointing at the edited task, if visible */
+  if (gtk_revealer_get_reveal_child (priv->edit_revealer))
+    {
+      edited_task = gtd_edit_pane_get_task (priv->edit_pane);
+      edited_row = edited_task ? g_hash_table_lookup (priv->task_to_row, edited_task) : NULL;
+
+      gtd_arrow_frame_set_row (priv->arrow_frame, edited_row);
+    }
+
+  if (priv->row_height == 0 && n_rows > 0)
+    {
+      gtk_widget_get_preferred_height (GTK_WIDGET (gtk_list_box_get_row_at_index (priv->listbox, 1)),
+                                       NULL,
+                                       &priv->row_height);
+      row_height = MAX (priv->row_height, 1);
+    }
+
+  gtk_widget_set_size_request (priv->top_spacer,
+                               -1,
+                               first * row_height);
+  gtk_widget_set_size_request (priv->bottom_spacer,
+                               -1,
+                               (priv->tasks->len - first - n_rows) * row_height);
+}
+
+static gboolean
+gtd_list_view__virtual_update_cb (gpointer user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+
+  view->priv->virtual_update_id = 0;
+
+  gtd_list_view__update_virtual_rows (view);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtd_list_view__queue_virtual_update (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  if (priv->virtual_mode && priv->virtual_update_id == 0)
+    priv->virtual_update_id = g_idle_add (gtd_list_view__virtual_update_cb, view);
+}
+
+static void
+gtd_list_view__adjustment_value_changed (GtdListView *view)
+{
+  /* Scrolling must not lag behind, so update right away */
+  if (view->priv->virtual_mode)
+    gtd_list_view__update_virtual_rows (view);
+}
+
+static void
+gtd_list_view__adjustment_changed (GtdListView *view)
+{
+  /*
+   * The page size and bounds change while the view is being
+   * allocated, so the rows are only rebound afterwards.
+   */
+  gtd_list_view__queue_virtual_update (view);
+}
+
+static void
+gtd_list_view__insert_task (GtdListView *view,
+                            GtdTask     *task,
+                            gboolean     animated)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  if (priv->virtual_mode)
+    {
+      /* Batches are sorted once, when the rows are updated */
+      if (priv->tasks_unsorted ||
+          (priv->task_list && gtd_object_get_updating (GTD_OBJECT (priv->task_list))))
+        {
+          g_ptr_array_add (priv->tasks, task);
+          priv->tasks_unsorted = TRUE;
+        }
+      else
+        {
+          guint low = 0;
+          guint high = priv->tasks->len;
+
+          /* Find the sorted position of the task */
+          while (low < high)
+            {
+              guint middle = (low + high) / 2;
+
+              if (gtd_list_view__compare (view, g_ptr_array_index (priv->tasks, middle), task) <= 0)
+                low = middle + 1;
+              else
+                high = middle;
+            }
+
+          g_ptr_array_insert (priv->tasks, low, task);
+        }
+
+      gtd_list_view__queue_virtual_update (view);
+    }
+  else
+    {
+      GtkWidget *new_row;
+
+      new_row = gtd_list_view__create_row (view, task);
+
+      gtk_list_box_insert (priv->listbox,
+                           new_row,
+                           0);
+      gtd_task_row_reveal (GTD_TASK_ROW (new_row), animated);
+
+      g_hash_table_insert (priv->task_to_row, task, new_row);
+
+      gtd_list_view__update_row_selection (view, GTD_TASK_ROW (new_row));
+    }
+}
+
+/*
+ * Moves the row of @task to its new sorted position, leaving the
+ * other rows untouched. gtk_list_box_row_changed() finds the new
+ * position with a binary search over the ordered rows.
+ */
+static void
+gtd_list_view__reposition_task (GtdListView *view,
+                                GtdTask     *task)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GtkListBoxRow *row;
+
+  if (priv->virtual_mode)
+    {
+      if (g_ptr_array_remove (priv->tasks, task))
+        gtd_list_view__insert_task (view, task, TRUE);
+
+      return;
+    }
+
+  row = g_hash_table_lookup (priv->task_to_row, task);
+
+  if (row)
+    gtk_list_box_row_changed (row);
+}
+
+static void
+gtd_list_view__reposition_tasks (GtdListView *view,
+                                 GList       *tasks)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GList *l;
+
+  if (priv->virtual_mode)
+    {
+      /* Sort once, when the rows are updated */
+      priv->tasks_unsorted = TRUE;
+      gtd_list_view__queue_virtual_update (view);
+    }
+  else if (g_list_length (tasks) > BULK_ANIMATION_THRESHOLD)
+    {
+      gtk_list_box_invalidate_sort (priv->listbox);
+    }
+  else
+    {
+      for (l = tasks; l != NULL; l = l->next)
+        gtd_list_view__reposition_task (view, l->data);
+    }
+}
+
+static gboolean
+gtd_list_view__populate_step (GtdListView *view,
+                              guint        min_rows)
+{
+  GtdListViewPrivate *priv = view->priv;
+  gint64 start_time;
+  guint n_rows;
+
+  start_time = g_get_monotonic_time ();
+  n_rows = 0;
+
+  while (!g_queue_is_empty (priv->pending_tasks))
+    {
+      GtdTask *task;
+
+      if (n_rows >= min_rows && g_get_monotonic_time () - start_time > POPULATE_FRAME_BUDGET)
+        return G_SOURCE_CONTINUE;
+
+      task = g_queue_pop_head (priv->pending_tasks);
+
+      /* The task may have been hidden or queued twice meanwhile */
+      if (g_hash_table_contains (priv->task_to_row, task) ||
+          (!priv->show_completed && gtd_task_get_complete (task)))
+        {
+          continue;
+        }
+
+      gtd_list_view__insert_task (view, task, priv->populate_animated);
+      n_rows++;
+    }
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+gtd_list_view__populate_tick_cb (GtkWidget     *widget,
+                                 GdkFrameClock *frame_clock,
+                                 gpointer       user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (widget);
+
+  if (gtd_list_view__populate_step (view, 0) == G_SOURCE_CONTINUE)
+    return G_SOURCE_CONTINUE;
+
+  view->priv->populate_tick_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+/*
+ * Creates the rows of the queued tasks. The first ones are created
+ * now, and the rest on the following frames.
+ */
+static void
+gtd_list_view__populate (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  if (priv->populate_tick_id > 0)
+    return;
+
+  /* Bulk insertions skip the row animations */
+  priv->populate_animated = g_queue_get_length (priv->pending_tasks) <= BULK_ANIMATION_THRESHOLD;
+
+  if (gtd_list_view__populate_step (view, POPULATE_FIRST_ROWS) == G_SOURCE_REMOVE)
+    return;
+
+  priv->populate_tick_id = gtk_widget_add_tick_callback (GTK_WIDGET (view),
+                                                         gtd_list_view__populate_tick_cb,
+                                                         NULL,
+                                                         NULL);
+}
+
+static void
+gtd_list_view__cancel_populate (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  if (priv->populate_tick_id > 0)
+    {
+      gtk_widget_remove_tick_callback (GTK_WIDGET (view), priv->populate_tick_id);
+      priv->populate_tick_id = 0;
+    }
+
+  g_queue_clear (priv->pending_tasks);
+}
+
+static void
+gtd_list_view__remove_rows (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GList *children;
+  GList *l;
+
+  gtd_list_view__cancel_populate (view);
+
+  children = gtk_container_get_children (GTK_CONTAINER (priv->listbox));
+
+  for (l = children; l != NULL; l = l->next)
+    {
+      if (l->data == priv->new_task_row)
+        continue;
+
+      /* Spacers are kept around, the task rows are destroyed */
+      if (l->data == priv->top_spacer || l->data == priv->bottom_spacer)
+        gtk_container_remove (GTK_CONTAINER (priv->listbox), l->data);
+      else
+        gtk_widget_destroy (l->data);
+    }
+
+  g_list_free (children);
+
+  g_hash_table_remove_all (priv->task_to_row);
+  g_ptr_array_set_size (priv->tasks, 0);
+  priv->n_virtual_rows = 0;
+}
+
+/*
+ * Regular rows are only queued here, and created in chunks
+ * by gtd_list_view__populate().
+ */
+static void
+gtd_list_view__show_task (GtdListView *view,
+                          GtdTask     *task)
+{
+  if (view->priv->virtual_mode)
+    gtd_list_view__insert_task (view, task, FALSE);
+  else
+    g_queue_push_tail (view->priv->pending_tasks, task);
+}
+
+static void
+gtd_list_view__add_task (GtdListView *view,
+                         GtdTask     *task)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+  g_return_if_fail (GTD_IS_TASK (task));
+
+  priv->n_tasks++;
+
+  if (gtd_task_get_complete (task))
+    priv->complete_tasks++;
+
+  if (priv->show_completed || !gtd_task_get_complete (task))
+    gtd_list_view__show_task (view, task);
+}
+
+static void
+gtd_list_view__task_change_free (TaskChange *change)
+{
+  g_object_unref (change->task);
+  g_free (change);
+}
+
+static void
+gtd_list_view__drop_changes (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+  TaskChange *change;
+
+  if (priv->changes_tick_id > 0)
+    {
+      gtk_widget_remove_tick_callback (GTK_WIDGET (view), priv->changes_tick_id);
+      priv->changes_tick_id = 0;
+    }
+
+  while ((change = g_queue_pop_head (priv->task_changes)) != NULL)
+    gtd_list_view__task_change_free (change);
+}
+
+static gboolean
+gtd_list_view__should_be_virtual (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+  guint n_visible;
+
+  /* The counters are kept up to date, so this doesn't walk the model */
+  n_visible = priv->n_tasks;
+
+  if (!priv->show_completed)
+    n_visible -= priv->complete_tasks;
+
+  return n_visible > VIRTUAL_THRESHOLD;
+}
+
+static void
+gtd_list_view__set_virtual_mode (GtdListView *view,
+                                 gboolean     virtual_mode)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GList *tasks;
+  GList *l;
+
+  if (priv->virtual_mode == virtual_mode)
+    return;
+
+  g_debug ("%s: %s virtual mode", G_STRFUNC, virtual_mode ? "entering" : "leaving");
+
+  /*
+   * Rebuild the rows in the new mode. The rows reflect the current
+   * state of the model, so queued model changes are dropped.
+   */
+  gtd_arrow_frame_set_row (priv->arrow_frame, NULL);
+  gtd_list_view__remove_rows (view);
+  gtd_list_view__drop_changes (view);
+
+  priv->virtual_mode = virtual_mode;
+  priv->complete_tasks = 0;
+  priv->n_tasks = 0;
+
+  if (virtual_mode)
+    {
+      gtk_list_box_insert (priv->listbox, priv->top_spacer, -1);
+      gtk_list_box_insert (priv->listbox, priv->bottom_spacer, -1);
+    }
+
+  tasks = gtd_list_view_get_list (view);
+  priv->tasks_unsorted = TRUE;
+
+  for (l = tasks; l != NULL; l = l->next)
+    gtd_list_view__add_task (view, l->data);
+
+  g_list_free (tasks);
+
+  gtd_list_view__populate (view);
+  gtd_list_view__update_virtual_rows (view);
+
+  gtd_list_view__update_done_label (view);
+}
+
+static void
+gtd_list_view__cancel_rebalance (GtdListView *view)
+{
+  if (view->priv->rebalance_id > 0)
+    {
+      g_source_remove (view->priv->rebalance_id);
+      view->priv->rebalance_id = 0;
+    }
+}
+
+static void
+gtd_list_view__clear_list (GtdListView *view)
+{
+  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+
+  view->priv->complete_tasks = 0;
+  view->priv->n_tasks = 0;
+  gtd_arrow_frame_set_row (view->priv->arrow_frame, NULL);
+
+  gtd_list_view__remove_rows (view);
+  gtd_list_view__drop_changes (view);
+  gtd_list_view__cancel_rebalance (view);
+  view->priv->virtual_mode = FALSE;
+
+  g_hash_table_remove_all (view->priv->selected_tasks);
+  gtd_list_view__selection_changed (view);
+
+  gtk_revealer_set_reveal_child (view->priv->revealer, FALSE);
+  gtk_revealer_set_reveal_child (view->priv->edit_revealer, FALSE);
+}
+
+/*
+ * Rebuilds the rows from the current model, i.e. the task list or
+ * the aggregate. If @sorted is %TRUE, the tasks come already sorted.
+ */
+static void
+gtd_list_view__load_tasks (GtdListView *view,
+                           gboolean     sorted)
+{
+  GtdListViewPrivate *priv = view->priv;
+  gboolean manual_order;
+  GList *task_list;
+  GList *l;
+  guint n_visible;
+
+  /* clear previous tasks */
+  gtd_list_view__clear_list (view);
+
+  /* Lists that were reordered before keep their manual order */
+  task_list = gtd_list_view_get_list (view);
+  manual_order = FALSE;
+  n_visible = 0;
+
+  for (l = task_list; l != NULL; l = l->next)
+    {
+      if (priv->task_list && !manual_order)
+        manual_order = gtd_task_get_position (l->data) != NULL;
+
+      if (priv->show_completed || !gtd_task_get_complete (l->data))
+        n_visible++;
+    }
+
+  g_list_free (task_list);
+
+  if (priv->manual_order != manual_order)
+    {
+      priv->manual_order = manual_order;
+      g_object_notify (G_OBJECT (view), "manual-order");
+    }
+
+  /*
+   * Big lists only create rows for the visible tasks. The counters
+   * aren't filled yet, so this can't use should_be_virtual().
+   */
+  if (n_visible > VIRTUAL_THRESHOLD)
+    {
+      priv->virtual_mode = TRUE;
+      priv->tasks_unsorted = !sorted || manual_order;
+
+      gtk_list_box_insert (priv->listbox, priv->top_spacer, -1);
+      gtk_list_box_insert (priv->listbox, priv->bottom_spacer, -1);
+    }
+
+  /* Add the tasks from the list */
+  task_list = gtd_list_view_get_list (view);
+
+  for (l = task_list; l != NULL; l = l->next)
+    {
+      gtd_list_view__add_task (view, l->data);
+
+      g_signal_connect (l->data,
+                        "notify::complete",
+                        G_CALLBACK (gtd_list_view__task_completed),
+                        view);
+    }
+
+  g_list_free (task_list);
+
+  gtd_list_view__populate (view);
+  gtd_list_view__update_virtual_rows (view);
+
+  gtd_list_view__update_done_label (view);
+}
+
+static void
+gtd_list_view__row_activated (GtkListBox *listbox,
+                              GtdTaskRow *row,
+                              gpointer    user_data)
+{
+  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
+
+  if (row == priv->new_task_row)
+    return;
+
+  /* In selection mode, rows are toggled instead of edited */
+  if (priv->selection_mode)
+    {
+      GtdTask *task = gtd_task_row_get_task (row);
+
+      if (!g_hash_table_remove (priv->selected_tasks, task))
+        g_hash_table_add (priv->selected_tasks, task);
+
+      gtd_list_view__update_row_selection (GTD_LIST_VIEW (user_data), row);
+      gtd_list_view__selection_changed (GTD_LIST_VIEW (user_data));
+      return;
+    }
+
+  gtd_edit_pane_set_task (priv->edit_pane, gtd_task_row_get_task (row));
+
+  gtk_revealer_set_reveal_child (priv->edit_revealer, TRUE);
+  gtd_arrow_frame_set_row (priv->arrow_frame, row);
+}
+
+static void
+gtd_list_view__remove_task (GtdListView *view,
+                            GtdTask     *task,
+                            gboolean     animated)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GtdTaskRow *row;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+  g_return_if_fail (GTD_IS_TASK (task));
+
+  if (g_hash_table_remove (priv->selected_tasks, task))
+    gtd_list_view__selection_changed (view);
+
+  if (priv->virtual_mode)
+    {
+      if (g_ptr_array_remove (priv->tasks, task))
+        gtd_list_view__queue_virtual_update (view);
+
+      return;
+    }
+
+  if (!g_queue_is_empty (priv->pending_tasks))
+    g_queue_remove_all (priv->pending_tasks, task);
+
+  row = g_hash_table_lookup (priv->task_to_row, task);
+
+  if (row)
+    {
+      g_hash_table_remove (priv->task_to_row, task);
+      gtd_task_row_destroy (row, animated);
+    }
+}
+
+/*
+ * Applies the model changes queued since the last frame at once,
+ * updating the done label and revealer only once.
+ */
+static void
+gtd_list_view__apply_changes (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+  TaskChange *change;
+  guint n_removed;
+  gboolean animated;
+  GList *l;
+
+  /* Bulk removals skip the row animations, like bulk insertions */
+  n_removed = 0;
+
+  for (l = priv->task_changes->head; l != NULL; l = l->next)
+    {
+      change = l->data;
+
+      if (change->type == TASK_REMOVED ||
+          (change->type == TASK_COMPLETE_CHANGED && change->complete && !priv->show_completed))
+        {
+          n_removed++;
+        }
+    }
+
+  animated = n_removed <= BULK_ANIMATION_THRESHOLD;
+
+  while ((change = g_queue_pop_head (priv->task_changes)) != NULL)
+    {
+      switch (change->type)
+        {
+        case TASK_ADDED:
+          priv->n_tasks++;
+
+          if (change->complete)
+            priv->complete_tasks++;
+
+          if (priv->show_completed || !change->complete)
+            gtd_list_view__show_task (view, change->task);
+          break;
+
+        case TASK_REMOVED:
+          priv->n_tasks--;
+
+          if (change->complete)
+            priv->complete_tasks--;
+
+          gtd_list_view__remove_task (view, change->task, animated);
+          break;
+
+        case TASK_COMPLETE_CHANGED:
+          if (change->complete)
+            priv->complete_tasks++;
+          else
+            priv->complete_tasks--;
+
+          if (priv->show_completed)
+            gtd_list_view__reposition_task (view, change->task);
+          else if (change->complete)
+            gtd_list_view__remove_task (view, change->task, animated);
+          else
+            gtd_list_view__show_task (view, change->task);
+          break;
+        }
+
+      gtd_list_view__task_change_free (change);
+    }
+
+  gtd_list_view__populate (view);
+
+  gtd_list_view__update_done_label (view);
+
+  /* The changes may have made the list too big for regular rows */
+  if (!priv->virtual_mode && gtd_list_view__should_be_virtual (view))
+    gtd_list_view__set_virtual_mode (view, TRUE);
+}
+
+static gboolean
+gtd_list_view__changes_tick_cb (GtkWidget     *widget,
+                                GdkFrameClock *frame_clock,
+                                gpointer       user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (widget);
+
+  view->priv->changes_tick_id = 0;
+
+  gtd_list_view__apply_changes (view);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtd_list_view__queue_change (GtdListView    *view,
+                             GtdTask        *task,
+                             TaskChangeType  type)
+{
+  GtdListViewPrivate *priv = view->priv;
+  TaskChange *change;
+
+  change = g_new0 (TaskChange, 1);
+  change->type = type;
+  change->task = g_object_ref (task);
+  change->complete = gtd_task_get_complete (task);
+
+  g_queue_push_tail (priv->task_changes, change);
+
+  if (priv->changes_tick_id == 0)
+    {
+      priv->changes_tick_id = gtk_widget_add_tick_callback (GTK_WIDGET (view),
+                                                            gtd_list_view__changes_tick_cb,
+                                                            NULL,
+                                                            NULL);
+    }
+}
+
+static void
+gtd_list_view__task_completed (GObject    *object,
+                               GParamSpec *spec,
+                               gpointer    user_data)
+{
+  GtdTask *task = GTD_TASK (object);
+
+  g_return_if_fail (GTD_IS_TASK (object));
+  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
+
+  /* GtdManager saves the task, views only update their rows */
+  gtd_list_view__queue_change (GTD_LIST_VIEW (user_data), task, TASK_COMPLETE_CHANGED);
+}
+
+static void
+gtd_list_view__task_added (GObject  *model,
+                           GtdTask  *task,
+                           gpointer  user_data)
+{
+  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
+  g_return_if_fail (GTD_IS_TASK (task));
+
+  g_signal_connect (task,
+                    "notify::complete",
+                    G_CALLBACK (gtd_list_view__task_completed),
+                    user_data);
+
+  /* Add the new task to the list */
+  gtd_list_view__queue_change (GTD_LIST_VIEW (user_data), task, TASK_ADDED);
+}
+
+static void
+gtd_list_view__task_removed (GObject  *model,
+                             GtdTask  *task,
+                             gpointer  user_data)
+{
+  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
+  g_return_if_fail (GTD_IS_TASK (task));
+
+  g_signal_handlers_disconnect_by_func (task,
+                                        gtd_list_view__task_completed,
+                                        user_data);
+
+  gtd_list_view__queue_change (GTD_LIST_VIEW (user_data), task, TASK_REMOVED);
+}
+
+static void
+gtd_list_view__list_updating_changed (GtdTaskList *list,
+                                      GParamSpec  *pspec,
+                                      gpointer     user_data)
+{
+  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
+
+  if (gtd_object_get_updating (GTD_OBJECT (list)))
+    return;
+
+  gtd_list_view__update_done_label (GTD_LIST_VIEW (user_data));
+
+  /* The batch may have made the list too big for regular rows */
+  if (!priv->virtual_mode && gtd_list_view__should_be_virtual (GTD_LIST_VIEW (user_data)))
+    gtd_list_view__set_virtual_mode (GTD_LIST_VIEW (user_data), TRUE);
+}
+
+static void
+gtd_list_view__create_task (GtdTaskRow *row,
+                            GtdTask    *task,
+                            gpointer    user_data)
+{
+  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
+  GtkWidget *new_row;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
+  g_return_if_fail (GTD_IS_TASK_ROW (row));
+  g_return_if_fail (GTD_IS_TASK (task));
+  g_return_if_fail (!priv->readonly);
+  g_return_if_fail (priv->task_list);
+
+  /*
+   * Newly created tasks are not aware of
+   * their parent lists.
+   */
+  gtd_task_set_list (task, priv->task_list);
+
+  /* In manual order, new tasks go to the end of the list */
+  if (priv->manual_order)
+    {
+      const gchar *last_position = NULL;
+      gchar *position;
+      GList *tasks;
+      GList *l;
+
+      tasks = gtd_task_list_get_tasks (priv->task_list);
+
+      for (l = tasks; l != NULL; l = l->next)
+        {
+          const gchar *task_position = gtd_task_get_position (l->data);
+
+          if (task_position && g_strcmp0 (task_position, last_position) > 0)
+            last_position = task_position;
+        }
+
+      position = gtd_fractional_index_between (last_position, NULL);
+      gtd_task_set_position (task, position);
+
+      g_list_free (tasks);
+      g_free (position);
+    }
+
+  gtd_task_list_save_task (priv->task_list, task);
+
+  gtd_manager_create_task (priv->manager, task);
+}
+
+/*
+ * Saves the changes made to @tasks: the lists are told once per
+ * task, the sources once per batch, and the rows are moved to
+ * their new positions.
+ */
+static void
+gtd_list_view__save_tasks (GtdListView *view,
+                           GList       *tasks)
+{
+  GList *l;
+
+  for (l = tasks; l != NULL; l = l->next)
+    {
+      gtd_task_save (l->data);
+      gtd_task_list_save_task (gtd_task_get_list (l->data), l->data);
+    }
+
+  gtd_manager_update_tasks (view->priv->manager, tasks);
+
+  gtd_list_view__reposition_tasks (view, tasks);
+}
+
+/*
+ * Retrieves all the tasks of the view, in the order they are shown,
+ * including the ones that are hidden or have no row right now.
+ */
+static GPtrArray*
+gtd_list_view__get_sorted_tasks (GtdListView *view)
+{
+  GPtrArray *tasks;
+  GList *list;
+  GList *l;
+
+  list = gtd_list_view_get_list (view);
+  tasks = g_ptr_array_sized_new (g_list_length (list));
+
+  for (l = list; l != NULL; l = l->next)
+    g_ptr_array_add (tasks, l->data);
+
+  g_ptr_array_sort_with_data (tasks, gtd_list_view__compare_tasks, view);
+
+  g_list_free (list);
+
+  return tasks;
+}
+
+/*
+ * Gives a position to the sorted @tasks. When @rebalance is %TRUE, all
+ * of them get short, evenly spread positions; otherwise, only the tasks
+ * without a position get one, after the last positioned task. Only the
+ * tasks whose position really changed are saved, in a single batch.
+ */
+static void
+gtd_list_view__assign_positions (GtdListView *view,
+                                 GPtrArray   *tasks,
+                                 gboolean     rebalance)
+{
+  const gchar *last_position;
+  GList *changed;
+  GList *lists;
+  gchar **keys;
+  guint i;
+
+  changed = NULL;
+  last_position = NULL;
+  keys = rebalance ? gtd_fractional_index_spread (tasks->len) : NULL;
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+      const gchar *position = gtd_task_get_position (task);
+
+      if (rebalance)
+        {
+          if (g_strcmp0 (position, keys[i]) == 0)
+            continue;
+
+          gtd_task_set_position (task, keys[i]);
+        }
+      else if (!position)
+        {
+          gchar *new_position = gtd_fractional_index_between (last_position, NULL);
+
+          gtd_task_set_position (task, new_position);
+
+          g_free (new_position);
+        }
+      else
+        {
+          last_position = position;
+          continue;
+        }
+
+      last_position = gtd_task_get_position (task);
+      changed = g_list_prepend (changed, task);
+    }
+
+  if (changed)
+    {
+      lists = gtd_list_view__begin_bulk_update (changed);
+
+      gtd_list_view__save_tasks (view, changed);
+
+      gtd_list_view__end_bulk_update (lists);
+    }
+
+  g_strfreev (keys);
+  g_list_free (changed);
+}
+
+static gboolean
+gtd_list_view__rebalance_cb (gpointer user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  GPtrArray *tasks;
+
+  view->priv->rebalance_id = 0;
+
+  if (!view->priv->manual_order)
+    return G_SOURCE_REMOVE;
+
+  g_debug ("%s: rebalancing task positions", G_STRFUNC);
+
+  tasks = gtd_list_view__get_sorted_tasks (view);
+  gtd_list_view__assign_positions (view, tasks, TRUE);
+
+  g_ptr_array_unref (tasks);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtd_list_view__queue_rebalance (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  /* Wait until the user is done reordering */
+  if (priv->rebalance_id > 0)
+    g_source_remove (priv->rebalance_id);
+
+  priv->rebalance_id = g_timeout_add_seconds (REBALANCE_DELAY, gtd_list_view__rebalance_cb, view);
+}
+
+/*
+ * Moves the dragged task before or after the row it was dropped on.
+ * Only the moved task gets a new position, right between its new
+ * neighbours, so a reorder writes exactly one task.
+ */
+static void
+gtd_list_view__drag_data_received (GtkWidget        *listbox,
+                                   GdkDragContext   *context,
+                                   gint              x,
+                                   gint              y,
+                                   GtkSelectionData *selection_data,
+                                   guint             info,
+                                   guint             time,
+                                   gpointer          user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  GtdListViewPrivate *priv = view->priv;
+  GtkListBoxRow *row;
+  GtkAllocation allocation;
+  GtdTask *target;
+  GtdTask *task;
+  GPtrArray *tasks;
+  const gchar *before;
+  const gchar *after;
+  gchar *position;
+  gboolean drop_after;
+  guint index;
+
+  task = priv->drag_task;
+
+  if (!task || !priv->task_list || priv->selection_mode || priv->readonly)
+    return;
+
+  row = gtk_list_box_get_row_at_y (GTK_LIST_BOX (listbox), y);
+
+  if ((GtkWidget*) row == priv->top_spacer || (GtkWidget*) row == priv->bottom_spacer)
+    return;
+
+  /* Dropping below the tasks, or on the new task row, moves to the end */
+  target = NULL;
+  drop_after = TRUE;
+
+  if (row && !gtd_task_row_get_new_task_mode (GTD_TASK_ROW (row)))
+    {
+      target = gtd_task_row_get_task (GTD_TASK_ROW (row));
+
+      gtk_widget_get_allocation (GTK_WIDGET (row), &allocation);
+      drop_after = y > allocation.y + allocation.height / 2;
+    }
+
+  if (target == task)
+    return;
+
+  tasks = gtd_list_view__get_sorted_tasks (view);
+
+  /* The first reorder switches the list to manual order */
+  if (!priv->manual_order)
+    {
+      gtd_list_view__assign_positions (view, tasks, TRUE);
+      gtd_list_view_set_manual_order (view, TRUE);
+    }
+  else
+    {
+      gtd_list_view__assign_positions (view, tasks, FALSE);
+    }
+
+  g_ptr_array_remove (tasks, task);
+
+  /* Find the neighbours of the drop location */
+  for (index = 0; index < tasks->len; index++)
+    {
+      if (g_ptr_array_index (tasks, index) == target)
+        break;
+    }
+
+  if (index < tasks->len && drop_after)
+    index++;
+
+  before = index > 0 ? gtd_task_get_position (g_ptr_array_index (tasks, index - 1)) : NULL;
+  after = index < tasks->len ? gtd_task_get_position (g_ptr_array_index (tasks, index)) : NULL;
+
+  /* Positions synced from elsewhere may clash, leaving no room in between */
+  if (before && after && strcmp (before, after) >= 0)
+    {
+      gtd_list_view__assign_positions (view, tasks, TRUE);
+
+      before = index > 0 ? gtd_task_get_position (g_ptr_array_index (tasks, index - 1)) : NULL;
+      after = index < tasks->len ? gtd_task_get_position (g_ptr_array_index (tasks, index)) : NULL;
+    }
+
+  position = gtd_fractional_index_between (before, after);
+
+  gtd_task_set_position (task, position);
+  gtd_task_save (task);
+
+  gtd_task_list_save_task (priv->task_list, task);
+  gtd_manager_update_task (priv->manager, task);
+
+  gtd_list_view__reposition_task (view, task);
+
+  if (strlen (position) > MAX_POSITION_LENGTH)
+    gtd_list_view__queue_rebalance (view);
+
+  g_ptr_array_unref (tasks);
+  g_free (position);
+}
+
+static void
+gtd_list_view__complete_selected (GSimpleAction *action,
+                                  GVariant      *parameter,
+                                  gpointer       user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  gboolean complete;
+  GList *changed;
+  GList *tasks;
+  GList *lists;
+  GList *l;
+
+  tasks = gtd_list_view_get_selected_tasks (view);
+  complete = FALSE;
+  changed = NULL;
+
+  /* Complete the selected tasks, or reopen them if all are complete */
+  for (l = tasks; l != NULL && !complete; l = l->next)
+    complete = !gtd_task_get_complete (l->data);
+
+  for (l = tasks; l != NULL; l = l->next)
+    {
+      if (gtd_task_get_complete (l->data) != complete)
+        changed = g_list_prepend (changed, l->data);
+    }
+
+  lists = gtd_list_view__begin_bulk_update (changed);
+
+  for (l = changed; l != NULL; l = l->next)
+    gtd_task_set_complete (l->data, complete);
+
+  gtd_list_view__save_tasks (view, changed);
+
+  gtd_list_view__end_bulk_update (lists);
+
+  gtd_list_view__unselect_all (view);
+
+  g_list_free (changed);
+  g_list_free (tasks);
+}
+
+static void
+gtd_list_view__delete_selected (GSimpleAction *action,
+                                GVariant      *parameter,
+                                gpointer       user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  RemoveTaskData *data;
+  GtdWindow *window;
+  GList *lists;
+  GList *l;
+  gchar *text;
+  guint n_tasks;
+
+  data = g_new0 (RemoveTaskData, 1);
+  data->view = view;
+  data->tasks = gtd_list_view_get_selected_tasks (view);
+
+  g_list_foreach (data->tasks, (GFunc) g_object_ref, NULL);
+
+  n_tasks = g_list_length (data->tasks);
+  text = g_strdup_printf (ngettext ("%d task removed", "%d tasks removed", n_tasks), n_tasks);
+  window = GTD_WINDOW (gtk_widget_get_toplevel (GTK_WIDGET (view)));
+
+  /* Remove the tasks from their lists */
+  lists = gtd_list_view__begin_bulk_update (data->tasks);
+
+  for (l = data->tasks; l != NULL; l = l->next)
+    gtd_task_list_remove_task (gtd_task_get_list (l->data), l->data);
+
+  gtd_list_view__end_bulk_update (lists);
+
+  gtd_list_view__unselect_all (view);
+  gtk_revealer_set_reveal_child (view->priv->edit_revealer, FALSE);
+
+  gtd_window_notify (window,
+                     7500, //ms
+                     TASK_REMOVED_NOTIFICATION_ID,
+                     text,
+                     _("Undo"),
+                     (GSourceFunc) remove_task_action,
+                     (GSourceFunc) undo_remove_task_action,
+                     FALSE,
+                     data);
+
+  g_free (text);
+}
+
+static GtdTaskList*
+gtd_list_view__get_list_by_uid (GtdListView *view,
+                                const gchar *uid)
+{
+  GtdTaskList *list;
+  GList *lists;
+  GList *l;
+
+  lists = gtd_manager_get_task_lists (view->priv->manager);
+  list = NULL;
+
+  for (l = lists; l != NULL && !list; l = l->next)
+    {
+      if (g_strcmp0 (e_source_get_uid (gtd_task_list_get_source (l->data)), uid) == 0)
+        list = l->data;
+    }
+
+  g_list_free (lists);
+
+  return list;
+}
+
+static void
+gtd_list_view__move_selected (GSimpleAction *action,
+                              GVariant      *parameter,
+                              gpointer       user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  GtdListViewPrivate *priv = view->priv;
+  GtdTaskList *target;
+  GList *tasks;
+
+  target = gtd_list_view__get_list_by_uid (view, g_variant_get_string (parameter, NULL));
+
+  if (!target)
+    return;
+
+  tasks = gtd_list_view_get_selected_tasks (view);
+
+  gtd_manager_move_tasks (priv->manager, tasks, target);
+
+  gtd_list_view__unselect_all (view);
+
+  g_list_free (tasks);
+}
+
+static void
+gtd_list_view__set_selected_priority (GSimpleAction *action,
+                                      GVariant      *parameter,
+                                      gpointer       user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  GList *tasks;
+  GList *lists;
+  GList *l;
+
+  tasks = gtd_list_view_get_selected_tasks (view);
+  lists = gtd_list_view__begin_bulk_update (tasks);
+
+  for (l = tasks; l != NULL; l = l->next)
+    gtd_task_set_priority (l->data, g_variant_get_int32 (parameter));
+
+  gtd_list_view__save_tasks (view, tasks);
+
+  gtd_list_view__end_bulk_update (lists);
+
+  gtd_list_view__unselect_all (view);
+
+  g_list_free (tasks);
+}
+
+static void
+gtd_list_view__set_selected_due_date (GtdListView *view,
+                                      GDateTime   *due_date)
+{
+  GList *tasks;
+  GList *lists;
+  GList *l;
+
+  tasks = gtd_list_view_get_selected_tasks (view);
+  lists = gtd_list_view__begin_bulk_update (tasks);
+
+  for (l = tasks; l != NULL; l = l->next)
+    gtd_task_set_due_date (l->data, due_date);
+
+  gtd_list_view__save_tasks (view, tasks);
+
+  gtd_list_view__end_bulk_update (lists);
+
+  gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (view->priv->date_button), FALSE);
+  gtd_list_view__unselect_all (view);
+
+  g_list_free (tasks);
+}
+
+static void
+gtd_list_view__set_date_button_clicked (GtkButton *button,
+                                        gpointer   user_data)
+{
+  GtdListView *view = GTD_LIST_VIEW (user_data);
+  GDateTime *due_date;
+  guint year;
+  guint month;
+  guint day;
+
+  gtk_calendar_get_date (view->priv->selection_calendar,
+                         &year,
+                         &month,
+                         &day);
+
+  due_date = g_date_time_new_local (year,
+                                    month + 1,
+                                    day,
+                                    0,
+                                    0,
+                                    0);
+
+  gtd_list_view__set_selected_due_date (view, due_date);
+
+  g_date_time_unref (due_date);
+}
+
+static void
+gtd_list_view__no_date_button_clicked (GtkButton *button,
+                                       gpointer   user_data)
+{
+  gtd_list_view__set_selected_due_date (GTD_LIST_VIEW (user_data), NULL);
+}
+
+static gint
+gtd_list_view__compare_lists (gconstpointer a,
+                              gconstpointer b)
+{
+  return g_strcmp0 (gtd_task_list_get_name ((GtdTaskList*) a),
+                    gtd_task_list_get_name ((GtdTaskList*) b));
+}
+
+/*
+ * Fills the "Move to" menu with the lists the selected tasks
+ * can be moved to, i.e. all but the list of this view.
+ */
+static void
+gtd_list_view__update_move_menu (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
+  GList *lists;
+  GList *l;
+  GMenu *menu;
+
+  menu = g_menu_new ();
+  lists = g_list_sort (gtd_manager_get_task_lists (priv->manager), gtd_list_view__compare_lists);
+
+  for (l = lists; l != NULL; l = l->next)
+    {
+      GMenuItem *item;
+
+      if (l->data == priv->task_list)
+        continue;
+
+      item = g_menu_item_new (gtd_task_list_get_name (l->data), NULL);
+      g_menu_item_set_action_and_target_value (item,
+                                               "view.move-selected",
+                                               g_variant_new_string (e_source_get_uid (gtd_task_list_get_source (l->data))));
+
+      g_menu_append_item (menu, item);
+      g_object_unref (item);
+    }
+
+  gtk_menu_button_set_menu_model (priv->move_button, G_MENU_MODEL (menu));
+
+  g_object_unref (menu);
+  g_list_free (lists);
+}
 
-  gtd_list_view__update_done_label (GTD_LIST_VIEW (user_data));
-  gtk_revealer_set_reveal_child (priv->revealer, priv->complete_tasks > 0);
+static void
+gtd_list_view__load_completed_tasks (GtdListView *view)
+{
+  GtdListViewPrivate *priv = view->priv;
 
-  if (!priv->show_completed)
+  if (!priv->manager)
+    return;
+
+  /*
+   * Completed tasks are fetched on demand: right away for an opened
+   * list, and only when they're shown for the aggregate, since that
+   * would fetch the completed tasks of every list.
+   */
+  if (priv->task_list)
     {
-      if (task_complete)
-        gtd_list_view__remove_task (GTD_LIST_VIEW (user_data), task);
-      else
-        gtd_list_view__add_task (GTD_LIST_VIEW (user_data), task);
+      gtd_manager_load_task_list (priv->manager, priv->task_list);
     }
-  else
+  else if (priv->aggregate && priv->show_completed)
     {
-      gtk_list_box_invalidate_sort (priv->listbox);
+      GList *lists;
+      GList *l;
+
+      lists = gtd_task_aggregate_get_lists (priv->aggregate);
+
+      for (l = lists; l != NULL; l = l->next)
+        gtd_manager_load_task_list (priv->manager, l->data);
+
+      g_list_free (lists);
     }
 }
 
 static void
-gtd_list_view__task_added (GtdTaskList *list,
-                           GtdTask     *task,
-                           gpointer     user_data)
+gtd_list_view__disconnect_task_list (GtdListView *view)
 {
-  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
+  GtdListViewPrivate *priv = view->priv;
+  GList *task_list;
+  GList *l;
 
-  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
-  g_return_if_fail (GTD_IS_TASK_LIST (list));
-  g_return_if_fail (GTD_IS_TASK (task));
+  if (!priv->task_list && !priv->aggregate)
+    return;
 
-  /* Add the new task to the list */
-  gtd_list_view__add_task (GTD_LIST_VIEW (user_data), task);
+  task_list = gtd_list_view_get_list (view);
+
+  for (l = task_list; l != NULL; l = l->next)
+    {
+      g_signal_handlers_disconnect_by_func (l->data,
+                                            gtd_list_view__task_completed,
+                                            view);
+    }
+
+  g_list_free (task_list);
+
+  if (priv->aggregate)
+    {
+      g_signal_handlers_disconnect_by_func (priv->aggregate,
+                                            gtd_list_view__task_added,
+                                            view);
+      g_signal_handlers_disconnect_by_func (priv->aggregate,
+                                            gtd_list_view__task_removed,
+                                            view);
+      return;
+    }
+
+  g_signal_handlers_disconnect_by_func (priv->task_list,
+                                        gtd_list_view__task_added,
+                                        view);
+  g_signal_handlers_disconnect_by_func (priv->task_list,
+                                        gtd_list_view__task_removed,
+                                        view);
+  g_signal_handlers_disconnect_by_func (priv->task_list,
+                                        gtd_list_view__color_changed,
+                                        view);
+  g_signal_handlers_disconnect_by_func (priv->task_list,
+                                        gtd_list_view__list_updating_changed,
+                                        view);
 }
 
 static void
-gtd_list_view__create_task (GtdTaskRow *row,
-                            GtdTask    *task,
-                            gpointer    user_data)
+gtd_list_view_dispose (GObject *object)
 {
-  GtdListViewPrivate *priv = GTD_LIST_VIEW (user_data)->priv;
-  GtkWidget *new_row;
+  GtdListView *self = GTD_LIST_VIEW (object);
 
-  g_return_if_fail (GTD_IS_LIST_VIEW (user_data));
-  g_return_if_fail (GTD_IS_TASK_ROW (row));
-  g_return_if_fail (GTD_IS_TASK (task));
-  g_return_if_fail (!priv->readonly);
-  g_return_if_fail (priv->task_list);
+  /* Views can be destroyed before their lists, e.g. when evicted from the window's cache */
+  gtd_list_view__disconnect_task_list (self);
+  self->priv->task_list = NULL;
+  self->priv->aggregate = NULL;
 
-  /*
-   * Newly created tasks are not aware of
-   * their parent lists.
-   */
-  gtd_task_set_list (task, priv->task_list);
-  gtd_task_list_save_task (priv->task_list, task);
+  gtd_list_view__cancel_populate (self);
+  gtd_list_view__cancel_rebalance (self);
+  gtd_list_view__drop_changes (self);
 
-  gtd_manager_create_task (priv->manager, task);
+  g_clear_object (&self->priv->drag_task);
+
+  G_OBJECT_CLASS (gtd_list_view_parent_class)->dispose (object);
 }
 
 static void
@@ -454,6 +2201,22 @@ gtd_list_view_finalize (GObject *object)
   GtdListView *self = (GtdListView *)object;
   GtdListViewPrivate *priv = gtd_list_view_get_instance_private (self);
 
+  if (priv->virtual_update_id > 0)
+    {
+      g_source_remove (priv->virtual_update_id);
+      priv->virtual_update_id = 0;
+    }
+
+  g_clear_pointer (&priv->color_class, g_free);
+  g_clear_pointer (&priv->task_to_row, g_hash_table_destroy);
+  g_clear_pointer (&priv->selected_tasks, g_hash_table_destroy);
+  g_clear_object (&priv->actions);
+  g_queue_free (priv->pending_tasks);
+  g_queue_free_full (priv->task_changes, (GDestroyNotify) gtd_list_view__task_change_free);
+  g_clear_pointer (&priv->tasks, g_ptr_array_unref);
+  g_clear_object (&priv->top_spacer);
+  g_clear_object (&priv->bottom_spacer);
+
   G_OBJECT_CLASS (gtd_list_view_parent_class)->finalize (object);
 }
 
@@ -471,6 +2234,10 @@ gtd_list_view_get_property (GObject    *object,
       g_value_set_object (value, self->priv->manager);
       break;
 
+    case PROP_MANUAL_ORDER:
+      g_value_set_boolean (value, self->priv->manual_order);
+      break;
+
     case PROP_SHOW_COMPLETED:
       g_value_set_boolean (value, self->priv->show_completed);
       break;
@@ -483,6 +2250,10 @@ gtd_list_view_get_property (GObject    *object,
       g_value_set_boolean (value, self->priv->readonly);
       break;
 
+    case PROP_SELECTION_MODE:
+      g_value_set_boolean (value, self->priv->selection_mode);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -492,21 +2263,39 @@ static void
 gtd_list_view_constructed (GObject *object)
 {
   GtdListView *self = GTD_LIST_VIEW (object);
+  GtkAdjustment *vadjustment;
 
   G_OBJECT_CLASS (gtd_list_view_parent_class)->constructed (object);
 
-  /* css provider */
-  self->priv->color_provider = gtk_css_provider_new ();
-
-  gtk_style_context_add_provider (gtk_widget_get_style_context (GTK_WIDGET (self->priv->viewport)),
-                                  GTK_STYLE_PROVIDER (self->priv->color_provider),
-                                  GTK_STYLE_PROVIDER_PRIORITY_APPLICATION + 2);
-
   /* show a nifty separator between lines */
   gtk_list_box_set_sort_func (self->priv->listbox,
                               (GtkListBoxSortFunc) gtd_list_view__listbox_sort_func,
-                              NULL,
+                              self,
                               NULL);
+
+  /* task rows can be dropped on the list to reorder it */
+  gtk_drag_dest_set (GTK_WIDGET (self->priv->listbox),
+                     GTK_DEST_DEFAULT_ALL,
+                     row_targets,
+                     G_N_ELEMENTS (row_targets),
+                     GDK_ACTION_MOVE);
+
+  g_signal_connect (self->priv->listbox,
+                    "drag-data-received",
+                    G_CALLBACK (gtd_list_view__drag_data_received),
+                    self);
+
+  /* rebind the virtual rows while scrolling */
+  vadjustment = gtk_scrollable_get_vadjustment (GTK_SCROLLABLE (self->priv->viewport));
+
+  g_signal_connect_swapped (vadjustment,
+                            "value-changed",
+                            G_CALLBACK (gtd_list_view__adjustment_value_changed),
+                            self);
+  g_signal_connect_swapped (vadjustment,
+                            "changed",
+                            G_CALLBACK (gtd_list_view__adjustment_changed),
+                            self);
 }
 
 static void
@@ -523,6 +2312,10 @@ gtd_list_view_set_property (GObject      *object,
       gtd_list_view_set_manager (self, g_value_get_object (value));
       break;
 
+    case PROP_MANUAL_ORDER:
+      gtd_list_view_set_manual_order (self, g_value_get_boolean (value));
+      break;
+
     case PROP_SHOW_COMPLETED:
       gtd_list_view_set_show_completed (self, g_value_get_boolean (value));
       break;
@@ -535,6 +2328,10 @@ gtd_list_view_set_property (GObject      *object,
       gtd_list_view_set_readonly (self, g_value_get_boolean (value));
       break;
 
+    case PROP_SELECTION_MODE:
+      gtd_list_view_set_selection_mode (self, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -546,6 +2343,7 @@ gtd_list_view_class_init (GtdListViewClass *klass)
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
+  object_class->dispose = gtd_list_view_dispose;
   object_class->finalize = gtd_list_view_finalize;
   object_class->constructed = gtd_list_view_constructed;
   object_class->get_property = gtd_list_view_get_property;
@@ -565,6 +2363,21 @@ gtd_list_view_class_init (GtdListViewClass *klass)
                              GTD_TYPE_MANAGER,
                              G_PARAM_READWRITE));
 
+  /**
+   * GtdListView::manual-order:
+   *
+   * Whether the tasks are sorted by the position the user dragged
+   * them to, instead of by priority and due date.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_MANUAL_ORDER,
+        g_param_spec_boolean ("manual-order",
+                              _("Whether the tasks are manually ordered"),
+                              _("Whether the tasks are sorted by the position they were dragged to"),
+                              FALSE,
+                              G_PARAM_READWRITE));
+
   /**
    * GtdListView::readonly:
    *
@@ -579,6 +2392,20 @@ gtd_list_view_class_init (GtdListViewClass *klass)
                               TRUE,
                               G_PARAM_READWRITE));
 
+  /**
+   * GtdListView::selection-mode:
+   *
+   * Whether rows are selected, instead of edited, when activated.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_SELECTION_MODE,
+        g_param_spec_boolean ("selection-mode",
+                              _("Whether the list is in selection mode"),
+                              _("Whether tasks are selected for bulk operations when activated"),
+                              FALSE,
+                              G_PARAM_READWRITE));
+
   /**
    * GtdListView::show-list-name:
    *
@@ -610,18 +2437,25 @@ gtd_list_view_class_init (GtdListViewClass *klass)
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gnome/todo/ui/list-view.ui");
 
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, arrow_frame);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdListView, date_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, edit_pane);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, edit_revealer);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, listbox);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdListView, move_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, revealer);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, done_image);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, done_label);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdListView, selection_bar);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdListView, selection_calendar);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdListView, selection_revealer);
   gtk_widget_class_bind_template_child_private (widget_class, GtdListView, viewport);
 
   gtk_widget_class_bind_template_callback (widget_class, gtd_list_view__done_button_clicked);
   gtk_widget_class_bind_template_callback (widget_class, gtd_list_view__edit_task_finished);
+  gtk_widget_class_bind_template_callback (widget_class, gtd_list_view__no_date_button_clicked);
   gtk_widget_class_bind_template_callback (widget_class, gtd_list_view__remove_task_cb);
   gtk_widget_class_bind_template_callback (widget_class, gtd_list_view__row_activated);
+  gtk_widget_class_bind_template_callback (widget_class, gtd_list_view__set_date_button_clicked);
 }
 
 static void
@@ -629,7 +2463,6 @@ gtd_list_view_init (GtdListView *self)
 {
   self->priv = gtd_list_view_get_instance_private (self);
   self->priv->readonly = TRUE;
-  self->priv->can_toggle = TRUE;
   self->priv->new_task_row = GTD_TASK_ROW (gtd_task_row_new (NULL));
   gtd_task_row_set_new_task_mode (self->priv->new_task_row, TRUE);
 
@@ -638,7 +2471,39 @@ gtd_list_view_init (GtdListView *self)
                     G_CALLBACK (gtd_list_view__create_task),
                     self);
 
+  self->priv->task_to_row = g_hash_table_new (g_direct_hash, g_direct_equal);
+  self->priv->selected_tasks = g_hash_table_new (g_direct_hash, g_direct_equal);
+  self->priv->pending_tasks = g_queue_new ();
+  self->priv->task_changes = g_queue_new ();
+
+  /* virtual mode */
+  self->priv->tasks = g_ptr_array_new ();
+
+  self->priv->top_spacer = g_object_ref_sink (gtk_list_box_row_new ());
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (self->priv->top_spacer), FALSE);
+  gtk_list_box_row_set_selectable (GTK_LIST_BOX_ROW (self->priv->top_spacer), FALSE);
+  gtk_widget_show (self->priv->top_spacer);
+
+  self->priv->bottom_spacer = g_object_ref_sink (gtk_list_box_row_new ());
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (self->priv->bottom_spacer), FALSE);
+  gtk_list_box_row_set_selectable (GTK_LIST_BOX_ROW (self->priv->bottom_spacer), FALSE);
+  gtk_widget_show (self->priv->bottom_spacer);
+
   gtk_widget_init_template (GTK_WIDGET (self));
+
+  /* bulk operations on the selected tasks */
+  self->priv->actions = g_simple_action_group_new ();
+
+  g_action_map_add_action_entries (G_ACTION_MAP (self->priv->actions),
+                                   gtd_list_view_entries,
+                                   G_N_ELEMENTS (gtd_list_view_entries),
+                                   self);
+
+  gtk_widget_insert_action_group (GTK_WIDGET (self),
+                                  "view",
+                                  G_ACTION_GROUP (self->priv->actions));
+
+  gtd_list_view__selection_changed (self);
 }
 
 /**
@@ -672,6 +2537,8 @@ gtd_list_view_get_list (GtdListView *view)
 
   if (view->priv->task_list)
     return gtd_task_list_get_tasks (view->priv->task_list);
+  else if (view->priv->aggregate)
+    return gtd_task_aggregate_get_tasks (view->priv->aggregate);
   else if (view->priv->list)
     return g_list_copy (view->priv->list);
   else
@@ -735,6 +2602,16 @@ gtd_list_view_set_manager (GtdListView *view,
       view->priv->manager = manager;
       gtd_edit_pane_set_manager (GTD_EDIT_PANE (view->priv->edit_pane), manager);
 
+      /* The shared list colors are dropped once, whatever the number of views */
+      if (!g_signal_handler_find (manager, G_SIGNAL_MATCH_FUNC, 0, 0, NULL, gtd_list_view__list_removed, NULL))
+        {
+          g_signal_connect (manager,
+                            "list-removed",
+                            G_CALLBACK (gtd_list_view__list_removed),
+                            NULL);
+        }
+      gtd_list_view__load_completed_tasks (view);
+
       g_object_notify (G_OBJECT (view), "manager");
     }
 }
@@ -797,6 +2674,134 @@ gtd_list_view_set_readonly (GtdListView *view,
     }
 }
 
+/**
+ * gtd_list_view_get_selection_mode:
+ * @view: a #GtdListView
+ *
+ * Whether @view is in selection mode.
+ *
+ * Returns: %TRUE if @view is in selection mode, %FALSE otherwise
+ */
+gboolean
+gtd_list_view_get_selection_mode (GtdListView *view)
+{
+  g_return_val_if_fail (GTD_IS_LIST_VIEW (view), FALSE);
+
+  return view->priv->selection_mode;
+}
+
+/**
+ * gtd_list_view_set_selection_mode:
+ * @view: a #GtdListView
+ * @selection_mode: %TRUE to enter selection mode, %FALSE to leave it
+ *
+ * Sets the GtdListView::selection-mode property of @view. In selection
+ * mode, activating a row selects its task, and the selected tasks can
+ * be completed, removed, moved or changed at once.
+ *
+ * Returns:
+ */
+void
+gtd_list_view_set_selection_mode (GtdListView *view,
+                                  gboolean     selection_mode)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+
+  if (priv->selection_mode != selection_mode)
+    {
+      priv->selection_mode = selection_mode;
+
+      if (selection_mode)
+        {
+          gtk_revealer_set_reveal_child (priv->edit_revealer, FALSE);
+          gtd_list_view__update_move_menu (view);
+        }
+      else
+        {
+          gtd_list_view__unselect_all (view);
+        }
+
+      gtk_revealer_set_reveal_child (priv->selection_revealer, selection_mode);
+
+      g_object_notify (G_OBJECT (view), "selection-mode");
+    }
+}
+
+/**
+ * gtd_list_view_get_manual_order:
+ * @view: a #GtdListView
+ *
+ * Whether the tasks of @view are sorted by the position they were
+ * dragged to.
+ *
+ * Returns: %TRUE if @view is manually ordered, %FALSE otherwise
+ */
+gboolean
+gtd_list_view_get_manual_order (GtdListView *view)
+{
+  g_return_val_if_fail (GTD_IS_LIST_VIEW (view), FALSE);
+
+  return view->priv->manual_order;
+}
+
+/**
+ * gtd_list_view_set_manual_order:
+ * @view: a #GtdListView
+ * @manual_order: %TRUE to sort by the dragged positions
+ *
+ * Sets the GtdListView::manual-order property of @view. Tasks without
+ * a position are shown after the positioned ones.
+ *
+ * Returns:
+ */
+void
+gtd_list_view_set_manual_order (GtdListView *view,
+                                gboolean     manual_order)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+
+  if (priv->manual_order != manual_order)
+    {
+      priv->manual_order = manual_order;
+
+      if (priv->virtual_mode)
+        {
+          priv->tasks_unsorted = TRUE;
+          gtd_list_view__queue_virtual_update (view);
+        }
+      else
+        {
+          gtk_list_box_invalidate_sort (priv->listbox);
+        }
+
+      if (!manual_order)
+        gtd_list_view__cancel_rebalance (view);
+
+      g_object_notify (G_OBJECT (view), "manual-order");
+    }
+}
+
+/**
+ * gtd_list_view_get_selected_tasks:
+ * @view: a #GtdListView
+ *
+ * Retrieves the tasks selected in @view, in no particular order.
+ *
+ * Returns: (element-type GtdTask) (transfer container): the selected
+ * tasks. Free with @g_list_free after use.
+ */
+GList*
+gtd_list_view_get_selected_tasks (GtdListView *view)
+{
+  g_return_val_if_fail (GTD_IS_LIST_VIEW (view), NULL);
+
+  return g_hash_table_get_keys (view->priv->selected_tasks);
+}
+
 /**
  * gtd_list_view_get_task_list:
  * @view: a #GtdListView
@@ -834,75 +2839,113 @@ gtd_list_view_set_task_list (GtdListView *view,
 
   if (priv->task_list != list)
     {
-      GdkRGBA *color;
-      gchar *color_str;
-      gchar *parsed_css;
-      GList *task_list;
-      GList *l;
+      GtkStyleContext *context;
 
       /*
        * Disconnect the old GtdTaskList signals.
        */
-      if (priv->task_list)
-        {
-          g_signal_handlers_disconnect_by_func (priv->task_list,
-                                                gtd_list_view__task_added,
-                                                view);
-          g_signal_handlers_disconnect_by_func (priv->task_list,
-                                                gtd_list_view__color_changed,
-                                                view);
-        }
+      gtd_list_view__disconnect_task_list (view);
+      priv->aggregate = NULL;
 
-      /* Add the color to provider */
-      color = gtd_task_list_get_color (list);
-      color_str = gdk_rgba_to_string (color);
+      /* Swap the color class */
+      context = gtk_widget_get_style_context (GTK_WIDGET (priv->viewport));
 
-      parsed_css = g_strdup_printf (COLOR_TEMPLATE, color_str);
+      if (priv->color_class)
+        gtk_style_context_remove_class (context, priv->color_class);
 
-      g_debug ("setting style for provider: %s", parsed_css);
+      g_free (priv->color_class);
+      priv->color_class = g_strdup (gtd_list_view__get_color_class (list));
 
-      gtk_css_provider_load_from_data (priv->color_provider,
-                                       parsed_css,
-                                       -1,
-                                       NULL);
-
-      gdk_rgba_free (color);
-      g_free (color_str);
+      gtk_style_context_add_class (context, priv->color_class);
 
       /* Load taska */
       priv->task_list = list;
-
-      /* clear previous tasks */
-      gtd_list_view__clear_list (view);
-
-      /* Add the tasks from the list */
-      task_list = gtd_task_list_get_tasks (list);
-
-      for (l = task_list; l != NULL; l = l->next)
-        {
-          gtd_list_view__add_task (view, l->data);
-
-          g_signal_connect (l->data,
-                            "notify::complete",
-                            G_CALLBACK (gtd_list_view__task_completed),
-                            view);
-        }
-
-      g_list_free (task_list);
+      gtd_list_view__load_tasks (view, FALSE);
+      gtd_list_view__load_completed_tasks (view);
 
       g_signal_connect (list,
                         "task-added",
                         G_CALLBACK (gtd_list_view__task_added),
                         view);
-      g_signal_connect_swapped (list,
-                                "task-removed",
-                                G_CALLBACK (gtd_list_view__remove_task),
-                                view);
+      g_signal_connect (list,
+                        "task-removed",
+                        G_CALLBACK (gtd_list_view__task_removed),
+                        view);
       g_signal_connect (list,
                         "notify::color",
                         G_CALLBACK (gtd_list_view__color_changed),
                         view);
+      g_signal_connect (list,
+                        "notify::updating",
+                        G_CALLBACK (gtd_list_view__list_updating_changed),
+                        view);
+    }
+}
+
+/**
+ * gtd_list_view_get_aggregate:
+ * @view: a #GtdListView
+ *
+ * Retrieves the #GtdTaskAggregate from @view, or %NULL if none was set.
+ *
+ * Returns: (transfer none): the #GtdTaskAggregate of @view, or %NULL if
+ * none was set.
+ */
+GtdTaskAggregate*
+gtd_list_view_get_aggregate (GtdListView *view)
+{
+  g_return_val_if_fail (GTD_IS_LIST_VIEW (view), NULL);
+
+  return view->priv->aggregate;
+}
+
+/**
+ * gtd_list_view_set_aggregate:
+ * @view: a #GtdListView
+ * @aggregate: a #GtdTaskAggregate
+ *
+ * Makes @view show the tasks of all the lists in @aggregate, and
+ * follow their changes. This replaces any #GtdTaskList set with
+ * gtd_list_view_set_task_list().
+ *
+ * Returns:
+ */
+void
+gtd_list_view_set_aggregate (GtdListView      *view,
+                             GtdTaskAggregate *aggregate)
+{
+  GtdListViewPrivate *priv = view->priv;
+
+  g_return_if_fail (GTD_IS_LIST_VIEW (view));
+  g_return_if_fail (GTD_IS_TASK_AGGREGATE (aggregate));
+
+  if (priv->aggregate == aggregate)
+    return;
+
+  gtd_list_view__disconnect_task_list (view);
+  priv->task_list = NULL;
+
+  /* Lists keep their own colors, so no color class */
+  if (priv->color_class)
+    {
+      gtk_style_context_remove_class (gtk_widget_get_style_context (GTK_WIDGET (priv->viewport)),
+                                      priv->color_class);
+      g_clear_pointer (&priv->color_class, g_free);
     }
+
+  /* The aggregate's tasks are already sorted */
+  priv->aggregate = aggregate;
+  gtd_list_view__load_tasks (view, TRUE);
+  gtd_list_view__load_completed_tasks (view);
+
+  g_signal_connect (aggregate,
+                    "task-added",
+                    G_CALLBACK (gtd_list_view__task_added),
+                    view);
+  g_signal_connect (aggregate,
+                    "task-removed",
+                    G_CALLBACK (gtd_list_view__task_removed),
+                    view);
 }
 
 /**
@@ -947,7 +2990,10 @@ gtd_list_view_set_show_list_name (GtdListView *view,
       children = gtk_container_get_children (GTK_CONTAINER (view->priv->listbox));
 
       for (l = children; l != NULL; l = l->next)
-        gtd_task_row_set_list_name_visible (l->data, show_list_name);
+        {
+          if (GTD_IS_TASK_ROW (l->data))
+            gtd_task_row_set_list_name_visible (l->data, show_list_name);
+        }
 
       g_list_free (children);
 
@@ -992,6 +3038,8 @@ gtd_list_view_set_show_completed (GtdListView *view,
     {
 
       priv->show_completed = show_completed;
+      gtd_list_view__load_completed_tasks (view);
+      gtd_list_view__update_done_label (view);
 
       gtk_image_set_from_icon_name (view->priv->done_image,
                                     show_completed ? "zoom-out-symbolic" : "zoom-in-symbolic",
@@ -999,50 +3047,87 @@ gtd_list_view_set_show_completed (GtdListView *view,
 
 
       /* insert or remove list rows */
-      if (show_completed)
+      if (priv->virtual_mode != gtd_list_view__should_be_virtual (view))
+        {
+          /* rebuilds the rows with the new set of tasks */
+          gtd_list_view__set_virtual_mode (view, !priv->virtual_mode);
+        }
+      else if (priv->virtual_mode)
         {
           GList *list_of_tasks;
           GList *l;
 
-          list_of_tasks = gtd_list_view_get_list (view);
+          if (show_completed)
+            {
+              list_of_tasks = gtd_list_view_get_list (view);
 
-          for (l = list_of_tasks; l != NULL; l = l->next)
+              for (l = list_of_tasks; l != NULL; l = l->next)
+                {
+                  if (gtd_task_get_complete (l->data))
+                    g_ptr_array_add (priv->tasks, l->data);
+                }
+
+              g_list_free (list_of_tasks);
+
+              priv->tasks_unsorted = TRUE;
+            }
+          else
             {
-              GtkWidget *new_row;
+              guint n_pending = 0;
+              guint i;
 
-              if (!gtd_task_get_complete (l->data))
-                continue;
+              /* Filter the completed tasks out, keeping the order */
+              for (i = 0; i < priv->tasks->len; i++)
+                {
+                  GtdTask *task = g_ptr_array_index (priv->tasks, i);
+
+                  if (!gtd_task_get_complete (task))
+                    priv->tasks->pdata[n_pending++] = task;
+                }
+
+              g_ptr_array_set_size (priv->tasks, n_pending);
+            }
 
-              new_row = gtd_task_row_new (l->data);
+          gtd_list_view__update_virtual_rows (view);
+        }
+      else if (show_completed)
+        {
+          GList *list_of_tasks;
+          GList *l;
 
-              gtk_list_box_insert (priv->listbox,
-                                   new_row,
-                                   0);
+          list_of_tasks = gtd_list_view_get_list (view);
 
-              gtd_task_row_reveal (GTD_TASK_ROW (new_row));
+          for (l = list_of_tasks; l != NULL; l = l->next)
+            {
+              if (gtd_task_get_complete (l->data))
+                g_queue_push_tail (priv->pending_tasks, l->data);
             }
 
+          gtd_list_view__populate (view);
+
             if (list_of_tasks)
               g_list_free (list_of_tasks);
         }
       else
         {
-          GList *children;
-          GList *l;
+          GHashTableIter iter;
+          gboolean animated;
+          gpointer task;
+          gpointer row;
 
-          children = gtk_container_get_children (GTK_CONTAINER (priv->listbox));
+          /* Bulk removals skip the row animations */
+          animated = priv->complete_tasks <= BULK_ANIMATION_THRESHOLD;
 
-          for (l = children; l != NULL; l = l->next)
+          g_hash_table_iter_init (&iter, priv->task_to_row);
+
+          while (g_hash_table_iter_next (&iter, &task, &row))
             {
-              if (!gtd_task_row_get_new_task_mode (l->data) &&
-                  gtd_task_get_complete (gtd_task_row_get_task (l->data)))
+              if (gtd_task_get_complete (task))
                 {
-                  gtd_task_row_destroy (l->data);
+                  g_hash_table_iter_remove (&iter);
+                  gtd_task_row_destroy (row, animated);
                 }
             }
-
-          if (children)
-              g_list_free (children);
         }
 
       g_object_notify (G_OBJECT (view), "show-completed");
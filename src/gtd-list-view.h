@@ -41,16 +41,33 @@ GtdManager*               gtd_list_view_get_manager             (GtdListView
 void                      gtd_list_view_set_manager             (GtdListView            *view,
                                                                  GtdManager             *manager);
 
+gboolean                  gtd_list_view_get_manual_order        (GtdListView            *view);
+
+void                      gtd_list_view_set_manual_order        (GtdListView            *view,
+                                                                 gboolean                manual_order);
+
 gboolean                  gtd_list_view_get_readonly            (GtdListView            *view);
 
 void                      gtd_list_view_set_readonly            (GtdListView            *view,
                                                                  gboolean                readonly);
 
+gboolean                  gtd_list_view_get_selection_mode      (GtdListView            *view);
+
+void                      gtd_list_view_set_selection_mode      (GtdListView            *view,
+                                                                 gboolean                selection_mode);
+
+GList*                    gtd_list_view_get_selected_tasks      (GtdListView            *view);
+
 GtdTaskList*              gtd_list_view_get_task_list           (GtdListView            *view);
 
 void                      gtd_list_view_set_task_list           (GtdListView            *view,
                                                                  GtdTaskList            *list);
 
+GtdTaskAggregate*         gtd_list_view_get_aggregate           (GtdListView            *view);
+
+void                      gtd_list_view_set_aggregate           (GtdListView            *view,
+                                                                 GtdTaskAggregate       *aggregate);
+
 gboolean                  gtd_list_view_get_show_list_name      (GtdListView            *view);
 
 void                      gtd_list_view_set_show_list_name      (GtdListView            *view,
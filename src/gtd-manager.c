@@ -27,15 +27,12 @@
 typedef struct
 {
   GHashTable            *clients;
+
+  /* lists whose completed tasks were fetched too, and when */
+  GHashTable            *loaded_lists;
+
   ECredentialsPrompter  *credentials_prompter;
   ESourceRegistry       *source_registry;
-
-  /*
-   * Small flag that contains the number of sources
-   * that still have to be loaded. When this number
-   * reaches 0, all sources are loaded.
-   */
-  gint                   load_sources;
 } GtdManagerPrivate;
 
 struct _GtdManager
@@ -65,6 +62,43 @@ enum
 
 static guint signals[NUM_SIGNALS] = { 0, };
 
+/*
+ * Connecting a source only fetches the tasks that aren't completed yet,
+ * which is all the overview shows. Completed tasks usually pile up and
+ * are only fetched for the lists that are actually opened.
+ */
+#define SUMMARY_QUERY                            "(not (is-completed?))"
+#define COMPLETED_QUERY                          "(is-completed?)"
+
+/*
+ * A move of tasks to another list. The tasks are created in the
+ * target list first, and only removed from their source lists
+ * after that succeeded, so a failure never loses a task.
+ */
+typedef struct
+{
+  ECalClient          *target_client;
+
+  /* every moved task, in the order they're created in the target */
+  GPtrArray           *tasks;
+
+  /* MoveGroup, one per source list */
+  GPtrArray           *groups;
+  guint                pending_groups;
+} MoveTasksData;
+
+typedef struct
+{
+  MoveTasksData       *data;
+
+  GtdTaskList         *source;
+  ECalClient          *client;
+  GPtrArray           *tasks;
+
+  /* ECalComponentId of the tasks in the source list */
+  GSList              *ids;
+} MoveGroup;
+
 static void
 gtd_manager__commit_source_finished (GObject      *registry,
                                      GAsyncResult *result,
@@ -75,7 +109,7 @@ gtd_manager__commit_source_finished (GObject      *registry,
 
   g_return_if_fail (GTD_IS_MANAGER (user_data));
 
-  gtd_object_set_ready (GTD_OBJECT (user_data), TRUE);
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
   e_source_registry_commit_source_finish (E_SOURCE_REGISTRY (registry),
                                           result,
                                           &error);
@@ -102,7 +136,7 @@ gtd_manager__remove_source_finished (GObject      *source,
 
   g_return_if_fail (GTD_IS_MANAGER (user_data));
 
-  gtd_object_set_ready (GTD_OBJECT (user_data), TRUE);
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
   e_source_remove_finish (E_SOURCE (source),
                           result,
                           &error);
@@ -133,7 +167,7 @@ gtd_manager__create_task_finished (GObject      *client,
                                                &new_uid,
                                                &error);
 
-  gtd_object_set_ready (GTD_OBJECT (user_data), TRUE);
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
 
   if (error)
     {
@@ -143,13 +177,14 @@ gtd_manager__create_task_finished (GObject      *client,
                  error->message);
 
       g_error_free (error);
-      return;
     }
   else if (new_uid)
     {
       gtd_object_set_uid (GTD_OBJECT (user_data), new_uid);
       g_free (new_uid);
     }
+
+  g_object_unref (user_data);
 }
 
 static void
@@ -164,7 +199,7 @@ gtd_manager__remove_task_finished (GObject      *client,
                                                result,
                                                &error);
 
-  gtd_object_set_ready (GTD_OBJECT (user_data), TRUE);
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
   g_object_unref (user_data);
 
   if (error)
@@ -191,7 +226,8 @@ gtd_manager__update_task_finished (GObject      *client,
                                                result,
                                                &error);
 
-  gtd_object_set_ready (GTD_OBJECT (user_data), TRUE);
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
+  g_object_unref (user_data);
 
   if (error)
     {
@@ -205,6 +241,348 @@ gtd_manager__update_task_finished (GObject      *client,
     }
 }
 
+static void
+gtd_manager__create_tasks_finished (GObject      *client,
+                                    GAsyncResult *result,
+                                    gpointer      user_data)
+{
+  GPtrArray *tasks = user_data;
+  GSList *new_uids = NULL;
+  GSList *l;
+  GError *error = NULL;
+  guint i;
+
+  e_cal_client_create_objects_finish (E_CAL_CLIENT (client),
+                                      result,
+                                      &new_uids,
+                                      &error);
+
+  /* The new uids come in the same order as the components */
+  for (i = 0, l = new_uids; i < tasks->len; i++)
+    {
+      GtdObject *task = g_ptr_array_index (tasks, i);
+
+      if (l)
+        {
+          gtd_object_set_uid (task, l->data);
+          l = l->next;
+        }
+
+      gtd_object_pop_operation (task);
+    }
+
+  g_slist_free_full (new_uids, g_free);
+  g_ptr_array_unref (tasks);
+
+  if (error)
+    {
+      g_warning ("%s: %s: %s",
+                 G_STRFUNC,
+                 _("Error creating tasks"),
+                 error->message);
+
+      g_error_free (error);
+      return;
+    }
+}
+
+static void
+gtd_manager__remove_tasks_finished (GObject      *client,
+                                    GAsyncResult *result,
+                                    gpointer      user_data)
+{
+  GPtrArray *tasks = user_data;
+  GError *error = NULL;
+
+  e_cal_client_remove_objects_finish (E_CAL_CLIENT (client),
+                                      result,
+                                      &error);
+
+  g_ptr_array_foreach (tasks, (GFunc) gtd_object_pop_operation, NULL);
+  g_ptr_array_unref (tasks);
+
+  if (error)
+    {
+      g_warning ("%s: %s: %s",
+                 G_STRFUNC,
+                 _("Error removing tasks"),
+                 error->message);
+
+      g_error_free (error);
+      return;
+    }
+}
+
+static void
+gtd_manager__update_tasks_finished (GObject      *client,
+                                    GAsyncResult *result,
+                                    gpointer      user_data)
+{
+  GPtrArray *tasks = user_data;
+  GError *error = NULL;
+
+  e_cal_client_modify_objects_finish (E_CAL_CLIENT (client),
+                                      result,
+                                      &error);
+
+  g_ptr_array_foreach (tasks, (GFunc) gtd_object_pop_operation, NULL);
+  g_ptr_array_unref (tasks);
+
+  if (error)
+    {
+      g_warning ("%s: %s: %s",
+                 G_STRFUNC,
+                 _("Error updating tasks"),
+                 error->message);
+
+      g_error_free (error);
+      return;
+    }
+}
+
+/*
+ * Groups @tasks by the ECalClient of their lists, so that each
+ * client receives a single request for all of its tasks. The
+ * values are arrays holding a reference to each task.
+ */
+static GHashTable*
+gtd_manager__group_tasks_by_client (GtdManager *manager,
+                                    GList      *tasks)
+{
+  GtdManagerPrivate *priv = manager->priv;
+  GHashTable *groups;
+  GList *l;
+
+  groups = g_hash_table_new_full (g_direct_hash,
+                                  g_direct_equal,
+                                  NULL,
+                                  (GDestroyNotify) g_ptr_array_unref);
+
+  for (l = tasks; l != NULL; l = l->next)
+    {
+      GPtrArray *group;
+      ECalClient *client;
+      ESource *source;
+
+      source = gtd_task_list_get_source (gtd_task_get_list (l->data));
+      client = g_hash_table_lookup (priv->clients, source);
+
+      if (!client)
+        {
+          g_warning ("%s: %s (%s)",
+                     G_STRFUNC,
+                     _("Skipping task of unknown list"),
+                     gtd_task_get_title (l->data));
+          continue;
+        }
+
+      group = g_hash_table_lookup (groups, client);
+
+      if (!group)
+        {
+          group = g_ptr_array_new_with_free_func (g_object_unref);
+          g_hash_table_insert (groups, client, group);
+        }
+
+      g_ptr_array_add (group, g_object_ref (l->data));
+    }
+
+  return groups;
+}
+
+/*
+ * Builds the list of icalcomponents of @tasks, marking each
+ * task as busy until the request finishes.
+ */
+static GSList*
+gtd_manager__get_components (GPtrArray *tasks)
+{
+  GSList *components = NULL;
+  gint i;
+
+  for (i = tasks->len - 1; i >= 0; i--)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+
+      gtd_object_push_operation (GTD_OBJECT (task));
+
+      components = g_slist_prepend (components,
+                                    e_cal_component_get_icalcomponent (gtd_task_get_component (task)));
+    }
+
+  return components;
+}
+
+static void
+move_group_free (MoveGroup *group)
+{
+  g_ptr_array_unref (group->tasks);
+  g_slist_free_full (group->ids, (GDestroyNotify) e_cal_component_free_id);
+  g_free (group);
+}
+
+static void
+move_tasks_data_free (MoveTasksData *data)
+{
+  g_ptr_array_unref (data->groups);
+  g_ptr_array_unref (data->tasks);
+  g_free (data);
+}
+
+/*
+ * Moves @tasks, all from the same list, to @list in the model,
+ * batching the changes of both lists.
+ */
+static void
+gtd_manager__set_tasks_list (GPtrArray   *tasks,
+                             GtdTaskList *list)
+{
+  GtdTaskList *source;
+  guint i;
+
+  if (tasks->len == 0)
+    return;
+
+  source = gtd_task_get_list (g_ptr_array_index (tasks, 0));
+
+  gtd_object_begin_update (GTD_OBJECT (source));
+  gtd_object_begin_update (GTD_OBJECT (list));
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+
+      gtd_task_list_remove_task (source, task);
+      gtd_task_set_list (task, list);
+      gtd_task_list_save_task (list, task);
+    }
+
+  gtd_object_end_update (GTD_OBJECT (list));
+  gtd_object_end_update (GTD_OBJECT (source));
+}
+
+static void
+gtd_manager__move_tasks_removed (GObject      *client,
+                                 GAsyncResult *result,
+                                 gpointer      user_data)
+{
+  MoveGroup *group = user_data;
+  MoveTasksData *data = group->data;
+  GError *error = NULL;
+
+  e_cal_client_remove_objects_finish (E_CAL_CLIENT (client),
+                                      result,
+                                      &error);
+
+  if (error)
+    {
+      GSList *copies = NULL;
+      GSList *l;
+      gint i;
+
+      g_warning ("%s: %s: %s",
+                 G_STRFUNC,
+                 _("Error removing moved tasks from their list"),
+                 error->message);
+
+      g_error_free (error);
+
+      /* The tasks are still in their source list, so drop their copies */
+      for (i = group->tasks->len - 1; i >= 0; i--)
+        {
+          GtdTask *task = g_ptr_array_index (group->tasks, i);
+
+          gtd_object_push_operation (GTD_OBJECT (task));
+
+          copies = g_slist_prepend (copies, e_cal_component_get_id (gtd_task_get_component (task)));
+        }
+
+      e_cal_client_remove_objects (data->target_client,
+                                   copies,
+                                   E_CAL_OBJ_MOD_THIS,
+                                   NULL, // We won't cancel the operation
+                                   (GAsyncReadyCallback) gtd_manager__remove_tasks_finished,
+                                   g_ptr_array_ref (group->tasks));
+
+      g_slist_free_full (copies, (GDestroyNotify) e_cal_component_free_id);
+
+      /* ...and put them back where they were */
+      for (i = 0, l = group->ids; l != NULL; i++, l = l->next)
+        {
+          ECalComponentId *id = l->data;
+
+          gtd_object_set_uid (g_ptr_array_index (group->tasks, i), id->uid);
+        }
+
+      gtd_manager__set_tasks_list (group->tasks, group->source);
+    }
+
+  g_ptr_array_foreach (group->tasks, (GFunc) gtd_object_pop_operation, NULL);
+
+  if (--data->pending_groups == 0)
+    move_tasks_data_free (data);
+}
+
+static void
+gtd_manager__move_tasks_created (GObject      *client,
+                                 GAsyncResult *result,
+                                 gpointer      user_data)
+{
+  MoveTasksData *data = user_data;
+  GSList *new_uids = NULL;
+  GSList *l;
+  GError *error = NULL;
+  guint i;
+
+  e_cal_client_create_objects_finish (E_CAL_CLIENT (client),
+                                      result,
+                                      &new_uids,
+                                      &error);
+
+  if (error)
+    {
+      g_warning ("%s: %s: %s",
+                 G_STRFUNC,
+                 _("Error moving tasks"),
+                 error->message);
+
+      g_error_free (error);
+
+      /* Nothing was removed yet, so moving the tasks back is enough */
+      for (i = 0; i < data->groups->len; i++)
+        {
+          MoveGroup *group = g_ptr_array_index (data->groups, i);
+
+          gtd_manager__set_tasks_list (group->tasks, group->source);
+        }
+
+      g_ptr_array_foreach (data->tasks, (GFunc) gtd_object_pop_operation, NULL);
+      move_tasks_data_free (data);
+      return;
+    }
+
+  /* The new uids come in the same order as the components */
+  for (i = 0, l = new_uids; i < data->tasks->len && l != NULL; i++, l = l->next)
+    gtd_object_set_uid (g_ptr_array_index (data->tasks, i), l->data);
+
+  g_slist_free_full (new_uids, g_free);
+
+  /* The tasks are safe in the target list, remove them from the sources */
+  data->pending_groups = data->groups->len;
+
+  for (i = 0; i < data->groups->len; i++)
+    {
+      MoveGroup *group = g_ptr_array_index (data->groups, i);
+
+      e_cal_client_remove_objects (group->client,
+                                   group->ids,
+                                   E_CAL_OBJ_MOD_THIS,
+                                   NULL, // We won't cancel the operation
+                                   (GAsyncReadyCallback) gtd_manager__move_tasks_removed,
+                                   group);
+    }
+}
+
 static void
 gtd_manager__invoke_authentication (GObject      *source_object,
                                     GAsyncResult *result,
@@ -307,6 +685,45 @@ gtd_manager__credentials_required (ESourceRegistry          *registry,
     }
 }
 
+static void
+gtd_manager__task_completed (GtdTask    *task,
+                             GParamSpec *pspec,
+                             GtdManager *manager)
+{
+  GtdTaskList *list = gtd_task_get_list (task);
+
+  /*
+   * Every view showing the task sees it changing, so it's saved here,
+   * once. Batches save all their tasks at once by themselves.
+   */
+  if (gtd_object_get_updating (GTD_OBJECT (list)))
+    return;
+
+  gtd_manager_update_task (manager, task);
+  gtd_task_list_save_task (list, task);
+}
+
+static void
+gtd_manager__task_added (GtdTaskList *list,
+                         GtdTask     *task,
+                         GtdManager  *manager)
+{
+  g_signal_connect (task,
+                    "notify::complete",
+                    G_CALLBACK (gtd_manager__task_completed),
+                    manager);
+}
+
+static void
+gtd_manager__task_removed (GtdTaskList *list,
+                           GtdTask     *task,
+                           GtdManager  *manager)
+{
+  g_signal_handlers_disconnect_by_func (task,
+                                        gtd_manager__task_completed,
+                                        manager);
+}
+
 static void
 gtd_manager__fill_task_list (GObject      *client,
                              GAsyncResult *result,
@@ -320,15 +737,42 @@ gtd_manager__fill_task_list (GObject      *client,
                                                 &component_list,
                                                 &error);
 
-  gtd_object_set_ready (GTD_OBJECT (user_data), TRUE);
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
 
   if (!error)
     {
+      GHashTable *uids;
+      GList *tasks;
       GSList *l;
+      GList *t;
+
+      /*
+       * Tasks fetched before, e.g. pending tasks that were completed in
+       * the meantime, are already in the list and are kept as they are.
+       */
+      uids = g_hash_table_new (g_str_hash, g_str_equal);
+      tasks = gtd_task_list_get_tasks (GTD_TASK_LIST (user_data));
+
+      for (t = tasks; t != NULL; t = t->next)
+        {
+          const gchar *uid = gtd_object_get_uid (t->data);
+
+          if (uid)
+            g_hash_table_add (uids, (gpointer) uid);
+        }
+
+      /* Let listeners resort and redraw only once for the whole list */
+      gtd_object_begin_update (GTD_OBJECT (user_data));
 
       for (l = component_list; l != NULL; l = l->next)
         {
           GtdTask *task;
+          const gchar *uid;
+
+          e_cal_component_get_uid (l->data, &uid);
+
+          if (uid && g_hash_table_contains (uids, uid))
+            continue;
 
           task = gtd_task_new (l->data);
           gtd_task_set_list (task, GTD_TASK_LIST (user_data));
@@ -336,6 +780,10 @@ gtd_manager__fill_task_list (GObject      *client,
           gtd_task_list_save_task (GTD_TASK_LIST (user_data), task);
         }
 
+      gtd_object_end_update (GTD_OBJECT (user_data));
+
+      g_hash_table_destroy (uids);
+      g_list_free (tasks);
       e_cal_client_free_ecalcomp_slist (component_list);
     }
   else
@@ -363,10 +811,8 @@ gtd_manager__on_client_connected (GObject      *source_object,
   source = e_client_get_source (E_CLIENT (source_object));
   client = E_CAL_CLIENT (e_cal_client_connect_finish (result, &error));
 
-  /* Update ready flag */
-  priv->load_sources--;
-  gtd_object_set_ready (GTD_OBJECT (user_data),
-                        priv->load_sources == 0);
+  /* The source is loaded, successfully or not */
+  gtd_object_pop_operation (GTD_OBJECT (user_data));
 
   if (!error)
     {
@@ -379,12 +825,22 @@ gtd_manager__on_client_connected (GObject      *source_object,
       /* creates a new task list */
       list = gtd_task_list_new (source, e_source_get_display_name (parent));
 
+      /* saves the tasks completed from any view */
+      g_signal_connect (list,
+                        "task-added",
+                        G_CALLBACK (gtd_manager__task_added),
+                        user_data);
+      g_signal_connect (list,
+                        "task-removed",
+                        G_CALLBACK (gtd_manager__task_removed),
+                        user_data);
+
       /* it's not ready until we fetch the list of tasks from client */
-      gtd_object_set_ready (GTD_OBJECT (list), FALSE);
+      gtd_object_push_operation (GTD_OBJECT (list));
 
-      /* asyncronously fetch the task list */
+      /* asyncronously fetch the pending tasks only */
       e_cal_client_get_object_list_as_comps (client,
-                                             "contains? \"any\" \"\"",
+                                             SUMMARY_QUERY,
                                              NULL,
                                              (GAsyncReadyCallback) gtd_manager__fill_task_list,
                                              list);
@@ -428,6 +884,9 @@ gtd_manager__load__source (GtdManager *manager,
   if (e_source_has_extension (source, E_SOURCE_EXTENSION_TASK_LIST) &&
       !g_hash_table_lookup (priv->clients, source))
     {
+      /* While there are sources to connect, GtdManager::ready = FALSE */
+      gtd_object_push_operation (GTD_OBJECT (manager));
+
       e_cal_client_connect (source,
                             E_CAL_CLIENT_SOURCE_TYPE_TASKS,
                             5, /* seconds to wait */
@@ -454,6 +913,7 @@ gtd_manager__remove_source (GtdManager *manager,
 
   list = g_object_get_data (G_OBJECT (source), "task-list");
 
+  g_hash_table_remove (priv->loaded_lists, list);
   g_hash_table_remove (priv->clients, source);
 
   g_signal_emit (manager,
@@ -501,15 +961,9 @@ gtd_manager__source_registry_finish_cb (GObject      *source_object,
   sources = e_source_registry_list_sources (priv->source_registry,
                                             E_SOURCE_EXTENSION_TASK_LIST);
 
-  /* While load_sources > 0, GtdManager::ready = FALSE */
-  priv->load_sources = g_list_length (sources);
-
   g_debug ("%s: number of sources to load: %d",
            G_STRFUNC,
-           priv->load_sources);
-
-  gtd_object_set_ready (GTD_OBJECT (user_data),
-                        priv->load_sources == 0);
+           g_list_length (sources));
 
   for (l = sources; l != NULL; l = l->next)
     gtd_manager__load__source (GTD_MANAGER (user_data), l->data);
@@ -541,6 +995,8 @@ gtd_manager_finalize (GObject *object)
   GtdManager *self = (GtdManager *)object;
   GtdManagerPrivate *priv = gtd_manager_get_instance_private (self);
 
+  g_clear_pointer (&priv->loaded_lists, g_hash_table_destroy);
+
   G_OBJECT_CLASS (gtd_manager_parent_class)->finalize (object);
 }
 
@@ -587,6 +1043,11 @@ gtd_manager_constructed (GObject *object)
                                          g_object_unref,
                                          g_object_unref);
 
+  priv->loaded_lists = g_hash_table_new_full (g_direct_hash,
+                                              g_direct_equal,
+                                              NULL,
+                                              g_free);
+
   /* load the source registry */
   e_source_registry_new (NULL,
                          (GAsyncReadyCallback) gtd_manager__source_registry_finish_cb,
@@ -707,13 +1168,13 @@ gtd_manager_create_task (GtdManager *manager,
   component = gtd_task_get_component (task);
 
   /* The task is not ready until we finish the operation */
-  gtd_object_set_ready (GTD_OBJECT (task), FALSE);
+  gtd_object_push_operation (GTD_OBJECT (task));
 
   e_cal_client_create_object (client,
                               e_cal_component_get_icalcomponent (component),
                               NULL, // We won't cancel the operation
                               (GAsyncReadyCallback) gtd_manager__create_task_finished,
-                              task);
+                              g_object_ref (task));
 }
 
 /**
@@ -744,7 +1205,7 @@ gtd_manager_remove_task (GtdManager *manager,
   id = e_cal_component_get_id (component);
 
   /* The task is not ready until we finish the operation */
-  gtd_object_set_ready (GTD_OBJECT (task), FALSE);
+  gtd_object_push_operation (GTD_OBJECT (task));
 
   e_cal_client_remove_object (client,
                               id->uid,
@@ -783,14 +1244,14 @@ gtd_manager_update_task (GtdManager *manager,
   component = gtd_task_get_component (task);
 
   /* The task is not ready until we finish the operation */
-  gtd_object_set_ready (GTD_OBJECT (task), FALSE);
+  gtd_object_push_operation (GTD_OBJECT (task));
 
   e_cal_client_modify_object (client,
                               e_cal_component_get_icalcomponent (component),
                               E_CAL_OBJ_MOD_THIS,
                               NULL, // We won't cancel the operation
                               (GAsyncReadyCallback) gtd_manager__update_task_finished,
-                              task);
+                              g_object_ref (task));
 }
 
 /**
@@ -814,7 +1275,7 @@ gtd_manager_remove_task_list (GtdManager  *manager,
 
   source = gtd_task_list_get_source (list);
 
-  gtd_object_set_ready (GTD_OBJECT (manager), FALSE);
+  gtd_object_push_operation (GTD_OBJECT (manager));
   e_source_remove (source,
                    NULL,
                    (GAsyncReadyCallback) gtd_manager__remove_source_finished,
@@ -842,10 +1303,395 @@ gtd_manager_save_task_list (GtdManager  *manager,
 
   source = gtd_task_list_get_source (list);
 
-  gtd_object_set_ready (GTD_OBJECT (manager), FALSE);
+  gtd_object_push_operation (GTD_OBJECT (manager));
   e_source_registry_commit_source (manager->priv->source_registry,
                                    source,
                                    NULL,
                                    (GAsyncReadyCallback) gtd_manager__commit_source_finished,
                                    manager);
 }
+
+/**
+ * gtd_manager_load_task_list:
+ * @manager: a #GtdManager
+ * @list: a #GtdTaskList
+ *
+ * Fetches the completed tasks of @list, which aren't fetched when
+ * its source is connected. Only the first call fetches anything, so
+ * this is cheap to call whenever @list is about to be shown.
+ *
+ * Returns:
+ */
+void
+gtd_manager_load_task_list (GtdManager  *manager,
+                            GtdTaskList *list)
+{
+  GtdManagerPrivate *priv;
+  ECalClient *client;
+  gint64 *load_time;
+
+  g_return_if_fail (GTD_IS_MANAGER (manager));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  priv = manager->priv;
+
+  if (g_hash_table_contains (priv->loaded_lists, list))
+    return;
+
+  client = g_hash_table_lookup (priv->clients, gtd_task_list_get_source (list));
+
+  if (!client)
+    return;
+
+  load_time = g_new (gint64, 1);
+  *load_time = g_get_monotonic_time ();
+
+  g_hash_table_insert (priv->loaded_lists, list, load_time);
+
+  gtd_object_push_operation (GTD_OBJECT (list));
+
+  e_cal_client_get_object_list_as_comps (client,
+                                         COMPLETED_QUERY,
+                                         NULL,
+                                         (GAsyncReadyCallback) gtd_manager__fill_task_list,
+                                         list);
+}
+
+/**
+ * gtd_manager_get_task_list_load_time:
+ * @manager: a #GtdManager
+ * @list: a #GtdTaskList
+ *
+ * Retrieves when gtd_manager_load_task_list() fetched the completed
+ * tasks of @list, in the g_get_monotonic_time() clock.
+ *
+ * Returns: the time @list was loaded, or 0 if it isn't loaded.
+ */
+gint64
+gtd_manager_get_task_list_load_time (GtdManager  *manager,
+                                     GtdTaskList *list)
+{
+  gint64 *load_time;
+
+  g_return_val_if_fail (GTD_IS_MANAGER (manager), 0);
+  g_return_val_if_fail (GTD_IS_TASK_LIST (list), 0);
+
+  load_time = g_hash_table_lookup (manager->priv->loaded_lists, list);
+
+  return load_time ? *load_time : 0;
+}
+
+/**
+ * gtd_manager_unload_task_list:
+ * @manager: a #GtdManager
+ * @list: a #GtdTaskList
+ *
+ * Drops the completed tasks of @list from memory, keeping its pending
+ * tasks. They're fetched again by the next gtd_manager_load_task_list()
+ * call. Lists whose tasks are still being fetched are left alone.
+ *
+ * Returns:
+ */
+void
+gtd_manager_unload_task_list (GtdManager  *manager,
+                              GtdTaskList *list)
+{
+  GtdManagerPrivate *priv;
+
+  g_return_if_fail (GTD_IS_MANAGER (manager));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  priv = manager->priv;
+
+  if (!g_hash_table_contains (priv->loaded_lists, list) ||
+      !gtd_object_get_ready (GTD_OBJECT (list)))
+    {
+      return;
+    }
+
+  g_debug ("%s: unloading completed tasks of list '%s'",
+           G_STRFUNC,
+           gtd_task_list_get_name (list));
+
+  g_hash_table_remove (priv->loaded_lists, list);
+
+  gtd_object_begin_update (GTD_OBJECT (list));
+  gtd_task_list_remove_completed_tasks (list);
+  gtd_object_end_update (GTD_OBJECT (list));
+}
+
+/**
+ * gtd_manager_get_task_lists:
+ * @manager: a #GtdManager
+ *
+ * Retrieves the task lists of all the connected sources.
+ *
+ * Returns: (element-type GtdTaskList) (transfer container): a #GList of
+ * #GtdTaskList. Free with @g_list_free after use.
+ */
+GList*
+gtd_manager_get_task_lists (GtdManager *manager)
+{
+  GHashTableIter iter;
+  GList *lists = NULL;
+  gpointer source;
+
+  g_return_val_if_fail (GTD_IS_MANAGER (manager), NULL);
+
+  g_hash_table_iter_init (&iter, manager->priv->clients);
+
+  while (g_hash_table_iter_next (&iter, &source, NULL))
+    lists = g_list_prepend (lists, g_object_get_data (source, "task-list"));
+
+  return lists;
+}
+
+/**
+ * gtd_manager_create_tasks:
+ * @manager: a #GtdManager
+ * @tasks: (element-type GtdTask): a #GList of #GtdTask
+ *
+ * Asks the parent list sources of @tasks to create them, with a
+ * single request per source.
+ *
+ * Returns:
+ */
+void
+gtd_manager_create_tasks (GtdManager *manager,
+                          GList      *tasks)
+{
+  GHashTableIter iter;
+  GHashTable *groups;
+  GPtrArray *group;
+  gpointer client;
+
+  g_return_if_fail (GTD_IS_MANAGER (manager));
+
+  groups = gtd_manager__group_tasks_by_client (manager, tasks);
+
+  g_hash_table_iter_init (&iter, groups);
+
+  while (g_hash_table_iter_next (&iter, &client, (gpointer*) &group))
+    {
+      GSList *components;
+
+      components = gtd_manager__get_components (group);
+
+      e_cal_client_create_objects (client,
+                                   components,
+                                   NULL, // We won't cancel the operation
+                                   (GAsyncReadyCallback) gtd_manager__create_tasks_finished,
+                                   g_ptr_array_ref (group));
+
+      g_slist_free (components);
+    }
+
+  g_hash_table_destroy (groups);
+}
+
+/**
+ * gtd_manager_remove_tasks:
+ * @manager: a #GtdManager
+ * @tasks: (element-type GtdTask): a #GList of #GtdTask
+ *
+ * Asks the parent list sources of @tasks to remove them, with a
+ * single request per source.
+ *
+ * Returns:
+ */
+void
+gtd_manager_remove_tasks (GtdManager *manager,
+                          GList      *tasks)
+{
+  GHashTableIter iter;
+  GHashTable *groups;
+  GPtrArray *group;
+  gpointer client;
+
+  g_return_if_fail (GTD_IS_MANAGER (manager));
+
+  groups = gtd_manager__group_tasks_by_client (manager, tasks);
+
+  g_hash_table_iter_init (&iter, groups);
+
+  while (g_hash_table_iter_next (&iter, &client, (gpointer*) &group))
+    {
+      GSList *ids = NULL;
+      gint i;
+
+      for (i = group->len - 1; i >= 0; i--)
+        {
+          GtdTask *task = g_ptr_array_index (group, i);
+
+          gtd_object_push_operation (GTD_OBJECT (task));
+
+          ids = g_slist_prepend (ids, e_cal_component_get_id (gtd_task_get_component (task)));
+        }
+
+      e_cal_client_remove_objects (client,
+                                   ids,
+                                   E_CAL_OBJ_MOD_THIS,
+                                   NULL, // We won't cancel the operation
+                                   (GAsyncReadyCallback) gtd_manager__remove_tasks_finished,
+                                   g_ptr_array_ref (group));
+
+      g_slist_free_full (ids, (GDestroyNotify) e_cal_component_free_id);
+    }
+
+  g_hash_table_destroy (groups);
+}
+
+/**
+ * gtd_manager_update_tasks:
+ * @manager: a #GtdManager
+ * @tasks: (element-type GtdTask): a #GList of #GtdTask
+ *
+ * Asks the parent list sources of @tasks to update them, with a
+ * single request per source.
+ *
+ * Returns:
+ */
+void
+gtd_manager_update_tasks (GtdManager *manager,
+                          GList      *tasks)
+{
+  GHashTableIter iter;
+  GHashTable *groups;
+  GPtrArray *group;
+  gpointer client;
+
+  g_return_if_fail (GTD_IS_MANAGER (manager));
+
+  groups = gtd_manager__group_tasks_by_client (manager, tasks);
+
+  g_hash_table_iter_init (&iter, groups);
+
+  while (g_hash_table_iter_next (&iter, &client, (gpointer*) &group))
+    {
+      GSList *components;
+
+      components = gtd_manager__get_components (group);
+
+      e_cal_client_modify_objects (client,
+                                   components,
+                                   E_CAL_OBJ_MOD_THIS,
+                                   NULL, // We won't cancel the operation
+                                   (GAsyncReadyCallback) gtd_manager__update_tasks_finished,
+                                   g_ptr_array_ref (group));
+
+      g_slist_free (components);
+    }
+
+  g_hash_table_destroy (groups);
+}
+
+/**
+ * gtd_manager_move_tasks:
+ * @manager: a #GtdManager
+ * @tasks: (element-type GtdTask): a #GList of #GtdTask
+ * @list: the #GtdTaskList to move @tasks to
+ *
+ * Moves @tasks to @list, even if they come from different sources.
+ * The model is updated right away. The tasks are created in @list's
+ * source with a single request, and only then removed from their
+ * sources, with one request per source. If any step fails, the
+ * affected tasks are moved back to their original lists.
+ *
+ * Returns:
+ */
+void
+gtd_manager_move_tasks (GtdManager  *manager,
+                        GList       *tasks,
+                        GtdTaskList *list)
+{
+  GtdManagerPrivate *priv;
+  MoveTasksData *data;
+  ECalClient *client;
+  GSList *components;
+  GList *l;
+  guint i;
+
+  g_return_if_fail (GTD_IS_MANAGER (manager));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  priv = manager->priv;
+  client = g_hash_table_lookup (priv->clients, gtd_task_list_get_source (list));
+
+  g_return_if_fail (client);
+
+  data = g_new0 (MoveTasksData, 1);
+  data->target_client = client;
+  data->tasks = g_ptr_array_new_with_free_func (g_object_unref);
+  data->groups = g_ptr_array_new_with_free_func ((GDestroyNotify) move_group_free);
+
+  for (l = tasks; l != NULL; l = l->next)
+    {
+      GtdTaskList *source;
+      MoveGroup *group;
+
+      source = gtd_task_get_list (l->data);
+      group = NULL;
+
+      if (source == list)
+        continue;
+
+      for (i = 0; i < data->groups->len && !group; i++)
+        {
+          if (((MoveGroup*) g_ptr_array_index (data->groups, i))->source == source)
+            group = g_ptr_array_index (data->groups, i);
+        }
+
+      if (!group)
+        {
+          client = g_hash_table_lookup (priv->clients, gtd_task_list_get_source (source));
+
+          if (!client)
+            {
+              g_warning ("%s: %s (%s)",
+                         G_STRFUNC,
+                         _("Skipping task of unknown list"),
+                         gtd_task_get_title (l->data));
+              continue;
+            }
+
+          group = g_new0 (MoveGroup, 1);
+          group->data = data;
+          group->source = source;
+          group->client = client;
+          group->tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+          g_ptr_array_add (data->groups, group);
+        }
+
+      g_ptr_array_add (group->tasks, g_object_ref (l->data));
+      group->ids = g_slist_prepend (group->ids, e_cal_component_get_id (gtd_task_get_component (l->data)));
+
+      g_ptr_array_add (data->tasks, g_object_ref (l->data));
+    }
+
+  if (data->tasks->len == 0)
+    {
+      move_tasks_data_free (data);
+      return;
+    }
+
+  /* Optimistically move the tasks in the model */
+  for (i = 0; i < data->groups->len; i++)
+    {
+      MoveGroup *group = g_ptr_array_index (data->groups, i);
+
+      group->ids = g_slist_reverse (group->ids);
+
+      gtd_manager__set_tasks_list (group->tasks, list);
+    }
+
+  components = gtd_manager__get_components (data->tasks);
+
+  e_cal_client_create_objects (data->target_client,
+                               components,
+                               NULL, // We won't cancel the operation
+                               (GAsyncReadyCallback) gtd_manager__move_tasks_created,
+                               data);
+
+  g_slist_free (components);
+}
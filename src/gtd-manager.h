@@ -42,6 +42,17 @@ void                    gtd_manager_remove_task_list      (GtdManager
 void                    gtd_manager_save_task_list        (GtdManager           *manager,
                                                            GtdTaskList          *list);
 
+GList*                  gtd_manager_get_task_lists        (GtdManager           *manager);
+
+void                    gtd_manager_load_task_list        (GtdManager           *manager,
+                                                           GtdTaskList          *list);
+
+void                    gtd_manager_unload_task_list      (GtdManager           *manager,
+                                                           GtdTaskList          *list);
+
+gint64                  gtd_manager_get_task_list_load_time (GtdManager         *manager,
+                                                             GtdTaskList        *list);
+
 /* Tasks */
 void                    gtd_manager_create_task           (GtdManager           *manager,
                                                            GtdTask              *task);
@@ -52,6 +63,19 @@ void                    gtd_manager_remove_task           (GtdManager
 void                    gtd_manager_update_task           (GtdManager           *manager,
                                                            GtdTask              *task);
 
+void                    gtd_manager_create_tasks          (GtdManager           *manager,
+                                                           GList                *tasks);
+
+void                    gtd_manager_remove_tasks          (GtdManager           *manager,
+                                                           GList                *tasks);
+
+void                    gtd_manager_update_tasks          (GtdManager           *manager,
+                                                           GList                *tasks);
+
+void                    gtd_manager_move_tasks            (GtdManager           *manager,
+                                                           GList                *tasks,
+                                                           GtdTaskList          *list);
+
 G_END_DECLS
 
 #endif /* GTD_MANAGER_H */
@@ -22,8 +22,24 @@
 
 typedef struct
 {
-  gboolean       ready;
   gchar         *uid;
+
+  /*
+   * Number of operations still running on the object. The
+   * object is ready when it reaches 0. total_operations counts
+   * every operation started since the object was last ready,
+   * and is used to report progress.
+   */
+  volatile gint  pending_operations;
+  volatile gint  total_operations;
+  gint           progress_percent;
+
+  /*
+   * Nesting level of gtd_object_begin_update() calls. While
+   * greater than 0, property notifications are queued and
+   * emitted only once when the outermost batch ends.
+   */
+  gint           update_count;
 } GtdObjectPrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtdObject, gtd_object, G_TYPE_OBJECT)
@@ -31,11 +47,31 @@ G_DEFINE_TYPE_WITH_PRIVATE (GtdObject, gtd_object, G_TYPE_OBJECT)
 enum
 {
   PROP_0,
+  PROP_PENDING_OPERATIONS,
+  PROP_PROGRESS,
   PROP_READY,
   PROP_UID,
+  PROP_UPDATING,
   LAST_PROP
 };
 
+static void
+gtd_object__update_progress (GtdObject *object)
+{
+  GtdObjectPrivate *priv = gtd_object_get_instance_private (object);
+  gint percent;
+
+  percent = (gint) (gtd_object_get_progress (object) * 100);
+
+  /* Only notify when the visible value changes */
+  if (priv->progress_percent != percent)
+    {
+      priv->progress_percent = percent;
+
+      g_object_notify (G_OBJECT (object), "progress");
+    }
+}
+
 static const gchar*
 gtd_object_real_get_uid (GtdObject *object)
 {
@@ -92,14 +128,26 @@ gtd_object_get_property (GObject    *object,
 
   switch (prop_id)
     {
+    case PROP_PENDING_OPERATIONS:
+      g_value_set_uint (value, gtd_object_get_pending_operations (self));
+      break;
+
+    case PROP_PROGRESS:
+      g_value_set_double (value, gtd_object_get_progress (self));
+      break;
+
     case PROP_READY:
-      g_value_set_boolean (value, priv->ready);
+      g_value_set_boolean (value, gtd_object_get_ready (self));
       break;
 
     case PROP_UID:
       g_value_set_string (value, GTD_OBJECT_GET_CLASS (self)->get_uid (self));
       break;
 
+    case PROP_UPDATING:
+      g_value_set_boolean (value, priv->update_count > 0);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -115,10 +163,6 @@ gtd_object_set_property (GObject      *object,
 
   switch (prop_id)
     {
-    case PROP_READY:
-      gtd_object_set_ready (self, g_value_get_boolean (value));
-      break;
-
     case PROP_UID:
       GTD_OBJECT_GET_CLASS (self)->set_uid (self, g_value_get_string (value));
       break;
@@ -154,10 +198,45 @@ gtd_object_class_init (GtdObjectClass *klass)
                              NULL,
                              G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
 
+  /**
+   * GtdObject::pending-operations:
+   *
+   * The number of operations still running on the object.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_PENDING_OPERATIONS,
+        g_param_spec_uint ("pending-operations",
+                           _("Pending operations of the object"),
+                           _("The number of operations still running on the object"),
+                           0,
+                           G_MAXUINT,
+                           0,
+                           G_PARAM_READABLE));
+
+  /**
+   * GtdObject::progress:
+   *
+   * The fraction of the operations started since the object was last
+   * ready that are already finished, from 0.0 to 1.0.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_PROGRESS,
+        g_param_spec_double ("progress",
+                             _("Progress of the object's operations"),
+                             _("The fraction of the running operations that are finished"),
+                             0.0,
+                             1.0,
+                             1.0,
+                             G_PARAM_READABLE));
+
   /**
    * GtdObject::ready:
    *
-   * Whether the object is ready or not.
+   * Whether the object is ready or not, i.e. whether there are
+   * no pending operations on it. It is only notified when the
+   * object goes from idle to busy and back.
    */
   g_object_class_install_property (
         object_class,
@@ -166,7 +245,24 @@ gtd_object_class_init (GtdObjectClass *klass)
                               _("Ready state of the object"),
                               _("Whether the object is marked as ready or not"),
                               TRUE,
-                              G_PARAM_READWRITE));
+                              G_PARAM_READABLE));
+
+  /**
+   * GtdObject::updating:
+   *
+   * Whether the object is inside a gtd_object_begin_update()
+   * batch. Listeners may defer expensive work (resorting, redrawing,
+   * saving) while this is %TRUE and do it once when it changes back
+   * to %FALSE.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_UPDATING,
+        g_param_spec_boolean ("updating",
+                              _("Whether the object is being updated"),
+                              _("Whether the object is inside a batch of changes"),
+                              FALSE,
+                              G_PARAM_READABLE));
 }
 
 static void
@@ -174,7 +270,7 @@ gtd_object_init (GtdObject *self)
 {
   GtdObjectPrivate *priv = gtd_object_get_instance_private (self);
 
-  priv->ready = TRUE;
+  priv->progress_percent = 100;
 }
 
 /**
@@ -239,7 +335,7 @@ gtd_object_set_uid (GtdObject   *object,
  * gtd_object_get_ready:
  * @object: a #GtdObject
  *
- * Whether @object is ready.
+ * Whether @object is ready, i.e. has no pending operations.
  *
  * Returns: %TRUE if @object is ready, %FALSE otherwise.
  */
@@ -252,30 +348,186 @@ gtd_object_get_ready (GtdObject *object)
 
   priv = gtd_object_get_instance_private (object);
 
-  return priv->ready;
+  return g_atomic_int_get (&priv->pending_operations) == 0;
+}
+
+/**
+ * gtd_object_get_pending_operations:
+ * @object: a #GtdObject
+ *
+ * Retrieves the number of operations still running on @object.
+ *
+ * Returns: the number of pending operations of @object.
+ */
+guint
+gtd_object_get_pending_operations (GtdObject *object)
+{
+  GtdObjectPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_OBJECT (object), 0);
+
+  priv = gtd_object_get_instance_private (object);
+
+  return g_atomic_int_get (&priv->pending_operations);
 }
 
 /**
- * gtd_object_set_ready:
+ * gtd_object_get_progress:
+ * @object: a #GtdObject
  *
- * Sets the GtdObject::ready property to @ready.
+ * Retrieves the fraction of the operations started since @object
+ * was last ready that are already finished.
+ *
+ * Returns: a value between 0.0 and 1.0, or 1.0 if @object is ready.
+ */
+gdouble
+gtd_object_get_progress (GtdObject *object)
+{
+  GtdObjectPrivate *priv;
+  gint pending;
+  gint total;
+
+  g_return_val_if_fail (GTD_IS_OBJECT (object), 1.0);
+
+  priv = gtd_object_get_instance_private (object);
+  pending = g_atomic_int_get (&priv->pending_operations);
+  total = g_atomic_int_get (&priv->total_operations);
+
+  if (total <= 0 || pending <= 0)
+    return 1.0;
+
+  return (gdouble) (total - pending) / total;
+}
+
+/**
+ * gtd_object_push_operation:
+ * @object: a #GtdObject
+ *
+ * Marks the start of an asynchronous operation on @object. The
+ * object is not ready until every pushed operation is popped
+ * with gtd_object_pop_operation().
  *
  * Returns:
  */
 void
-gtd_object_set_ready (GtdObject *object,
-                      gboolean   ready)
+gtd_object_push_operation (GtdObject *object)
 {
   GtdObjectPrivate *priv;
 
-  g_assert (GTD_IS_OBJECT (object));
+  g_return_if_fail (GTD_IS_OBJECT (object));
 
   priv = gtd_object_get_instance_private (object);
 
-  if (priv->ready != ready)
-    {
-      priv->ready = ready;
+  g_atomic_int_inc (&priv->total_operations);
+
+  if (g_atomic_int_add (&priv->pending_operations, 1) == 0)
+    g_object_notify (G_OBJECT (object), "ready");
 
+  g_object_notify (G_OBJECT (object), "pending-operations");
+  gtd_object__update_progress (object);
+}
+
+/**
+ * gtd_object_pop_operation:
+ * @object: a #GtdObject
+ *
+ * Marks the end of an operation started with gtd_object_push_operation().
+ *
+ * Returns:
+ */
+void
+gtd_object_pop_operation (GtdObject *object)
+{
+  GtdObjectPrivate *priv;
+
+  g_return_if_fail (GTD_IS_OBJECT (object));
+
+  priv = gtd_object_get_instance_private (object);
+
+  g_return_if_fail (g_atomic_int_get (&priv->pending_operations) > 0);
+
+  if (g_atomic_int_dec_and_test (&priv->pending_operations))
+    {
+      g_atomic_int_set (&priv->total_operations, 0);
       g_object_notify (G_OBJECT (object), "ready");
     }
+
+  g_object_notify (G_OBJECT (object), "pending-operations");
+  gtd_object__update_progress (object);
+}
+
+/**
+ * gtd_object_begin_update:
+ * @object: a #GtdObject
+ *
+ * Starts a batch of changes on @object. Property notifications
+ * are held back until the matching call to gtd_object_end_update(),
+ * and each changed property is then notified only once, no matter
+ * how many times it was set. Calls can be nested.
+ *
+ * Returns:
+ */
+void
+gtd_object_begin_update (GtdObject *object)
+{
+  GtdObjectPrivate *priv;
+
+  g_return_if_fail (GTD_IS_OBJECT (object));
+
+  priv = gtd_object_get_instance_private (object);
+
+  if (priv->update_count++ == 0)
+    {
+      /* Notify before freezing, so listeners learn about the batch now */
+      g_object_notify (G_OBJECT (object), "updating");
+      g_object_freeze_notify (G_OBJECT (object));
+    }
+}
+
+/**
+ * gtd_object_end_update:
+ * @object: a #GtdObject
+ *
+ * Finishes a batch of changes started with gtd_object_begin_update().
+ * When the outermost batch ends, the queued property notifications
+ * are emitted, followed by a notification of GtdObject::updating.
+ *
+ * Returns:
+ */
+void
+gtd_object_end_update (GtdObject *object)
+{
+  GtdObjectPrivate *priv;
+
+  g_return_if_fail (GTD_IS_OBJECT (object));
+
+  priv = gtd_object_get_instance_private (object);
+
+  g_return_if_fail (priv->update_count > 0);
+
+  if (--priv->update_count == 0)
+    {
+      g_object_thaw_notify (G_OBJECT (object));
+      g_object_notify (G_OBJECT (object), "updating");
+    }
+}
+
+/**
+ * gtd_object_get_updating:
+ * @object: a #GtdObject
+ *
+ * Whether @object is inside a gtd_object_begin_update() batch.
+ *
+ * Returns: %TRUE if @object is being updated, %FALSE otherwise.
+ */
+gboolean
+gtd_object_get_updating (GtdObject *object)
+{
+  GtdObjectPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_OBJECT (object), FALSE);
+
+  priv = gtd_object_get_instance_private (object);
+
+  return priv->update_count > 0;
 }
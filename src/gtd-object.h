@@ -48,8 +48,19 @@ void                    gtd_object_set_uid                (GtdObject          *o
 
 gboolean                gtd_object_get_ready              (GtdObject          *object);
 
-void                    gtd_object_set_ready              (GtdObject          *object,
-                                                           gboolean            ready);
+guint                   gtd_object_get_pending_operations (GtdObject          *object);
+
+gdouble                 gtd_object_get_progress           (GtdObject          *object);
+
+void                    gtd_object_push_operation         (GtdObject          *object);
+
+void                    gtd_object_pop_operation          (GtdObject          *object);
+
+void                    gtd_object_begin_update           (GtdObject          *object);
+
+void                    gtd_object_end_update             (GtdObject          *object);
+
+gboolean                gtd_object_get_updating           (GtdObject          *object);
 
 G_END_DECLS
 
@@ -0,0 +1,462 @@
+/* gtd-task-aggregate.c
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtd-task.h"
+#include "gtd-task-aggregate.h"
+#include "gtd-task-list.h"
+
+/*
+ * GtdTaskAggregate presents the tasks of many GtdTaskLists as one
+ * sorted stream. Each list's tasks are kept sorted on their own, and
+ * updated incrementally as the lists change; the stream is a k-way
+ * merge of these per-list orders.
+ */
+
+typedef struct
+{
+  GtdTaskList         *list;
+  GPtrArray           *tasks;
+} ListEntry;
+
+typedef struct
+{
+  GPtrArray           *entries;
+} GtdTaskAggregatePrivate;
+
+struct _GtdTaskAggregate
+{
+  GObject                  parent;
+
+  /*<private>*/
+  GtdTaskAggregatePrivate *priv;
+};
+
+typedef struct
+{
+  GPtrArray           *tasks;
+  guint                position;
+} MergeCursor;
+
+G_DEFINE_TYPE_WITH_PRIVATE (GtdTaskAggregate, gtd_task_aggregate, G_TYPE_OBJECT)
+
+enum
+{
+  TASK_ADDED,
+  TASK_REMOVED,
+  NUM_SIGNALS
+};
+
+static guint signals[NUM_SIGNALS] = { 0, };
+
+static gint
+gtd_task_aggregate__compare_tasks (gconstpointer a,
+                                   gconstpointer b)
+{
+  return gtd_task_compare (*((GtdTask**) a), *((GtdTask**) b));
+}
+
+static void
+gtd_task_aggregate__insert_sorted (GPtrArray *tasks,
+                                   GtdTask   *task)
+{
+  guint low = 0;
+  guint high = tasks->len;
+
+  while (low < high)
+    {
+      guint middle = (low + high) / 2;
+
+      if (gtd_task_compare (g_ptr_array_index (tasks, middle), task) <= 0)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+  g_ptr_array_insert (tasks, low, task);
+}
+
+static ListEntry*
+gtd_task_aggregate__find_entry (GtdTaskAggregate *aggregate,
+                                GtdTaskList      *list)
+{
+  GPtrArray *entries = aggregate->priv->entries;
+  guint i;
+
+  for (i = 0; i < entries->len; i++)
+    {
+      ListEntry *entry = g_ptr_array_index (entries, i);
+
+      if (entry->list == list)
+        return entry;
+    }
+
+  return NULL;
+}
+
+static void
+gtd_task_aggregate__list_entry_free (ListEntry *entry)
+{
+  g_ptr_array_unref (entry->tasks);
+  g_object_unref (entry->list);
+  g_free (entry);
+}
+
+static void
+gtd_task_aggregate__task_added (GtdTaskList *list,
+                                GtdTask     *task,
+                                gpointer     user_data)
+{
+  GtdTaskAggregate *aggregate = GTD_TASK_AGGREGATE (user_data);
+  ListEntry *entry;
+
+  entry = gtd_task_aggregate__find_entry (aggregate, list);
+
+  g_return_if_fail (entry != NULL);
+
+  gtd_task_aggregate__insert_sorted (entry->tasks, task);
+
+  g_signal_emit (aggregate, signals[TASK_ADDED], 0, task);
+}
+
+static void
+gtd_task_aggregate__task_removed (GtdTaskList *list,
+                                  GtdTask     *task,
+                                  gpointer     user_data)
+{
+  GtdTaskAggregate *aggregate = GTD_TASK_AGGREGATE (user_data);
+  ListEntry *entry;
+
+  entry = gtd_task_aggregate__find_entry (aggregate, list);
+
+  g_return_if_fail (entry != NULL);
+
+  if (g_ptr_array_remove (entry->tasks, task))
+    g_signal_emit (aggregate, signals[TASK_REMOVED], 0, task);
+}
+
+static void
+gtd_task_aggregate__task_updated (GtdTaskList *list,
+                                  GtdTask     *task,
+                                  gpointer     user_data)
+{
+  ListEntry *entry;
+
+  entry = gtd_task_aggregate__find_entry (GTD_TASK_AGGREGATE (user_data), list);
+
+  g_return_if_fail (entry != NULL);
+
+  /* The task may have moved within its list's order */
+  if (g_ptr_array_remove (entry->tasks, task))
+    gtd_task_aggregate__insert_sorted (entry->tasks, task);
+}
+
+static gint
+gtd_task_aggregate__compare_cursors (MergeCursor *c1,
+                                     MergeCursor *c2)
+{
+  return gtd_task_compare (g_ptr_array_index (c1->tasks, c1->position),
+                           g_ptr_array_index (c2->tasks, c2->position));
+}
+
+static void
+gtd_task_aggregate__sift_down (MergeCursor *heap,
+                               guint        n_cursors,
+                               guint        index)
+{
+  while (TRUE)
+    {
+      MergeCursor tmp;
+      guint smallest = index;
+      guint left = 2 * index + 1;
+      guint right = 2 * index + 2;
+
+      if (left < n_cursors && gtd_task_aggregate__compare_cursors (&heap[left], &heap[smallest]) < 0)
+        smallest = left;
+
+      if (right < n_cursors && gtd_task_aggregate__compare_cursors (&heap[right], &heap[smallest]) < 0)
+        smallest = right;
+
+      if (smallest == index)
+        break;
+
+      tmp = heap[index];
+      heap[index] = heap[smallest];
+      heap[smallest] = tmp;
+
+      index = smallest;
+    }
+}
+
+static void
+gtd_task_aggregate_finalize (GObject *object)
+{
+  GtdTaskAggregate *self = (GtdTaskAggregate *)object;
+  GtdTaskAggregatePrivate *priv = gtd_task_aggregate_get_instance_private (self);
+
+  while (priv->entries->len > 0)
+    {
+      ListEntry *entry = g_ptr_array_index (priv->entries, 0);
+
+      gtd_task_aggregate_remove_list (self, entry->list);
+    }
+
+  g_ptr_array_unref (priv->entries);
+
+  G_OBJECT_CLASS (gtd_task_aggregate_parent_class)->finalize (object);
+}
+
+static void
+gtd_task_aggregate_class_init (GtdTaskAggregateClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = gtd_task_aggregate_finalize;
+
+  /**
+   * GtdTaskAggregate::task-added:
+   *
+   * The ::task-added signal is emmited after a #GtdTask
+   * is added to one of the aggregated lists.
+   */
+  signals[TASK_ADDED] = g_signal_new ("task-added",
+                                      GTD_TYPE_TASK_AGGREGATE,
+                                      G_SIGNAL_RUN_LAST,
+                                      0,
+                                      NULL,
+                                      NULL,
+                                      NULL,
+                                      G_TYPE_NONE,
+                                      1,
+                                      GTD_TYPE_TASK);
+
+  /**
+   * GtdTaskAggregate::task-removed:
+   *
+   * The ::task-removed signal is emmited after a #GtdTask
+   * is removed from one of the aggregated lists, or when its
+   * list is removed from the aggregate.
+   */
+  signals[TASK_REMOVED] = g_signal_new ("task-removed",
+                                        GTD_TYPE_TASK_AGGREGATE,
+                                        G_SIGNAL_RUN_LAST,
+                                        0,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        G_TYPE_NONE,
+                                        1,
+                                        GTD_TYPE_TASK);
+}
+
+static void
+gtd_task_aggregate_init (GtdTaskAggregate *self)
+{
+  self->priv = gtd_task_aggregate_get_instance_private (self);
+  self->priv->entries = g_ptr_array_new_with_free_func ((GDestroyNotify) gtd_task_aggregate__list_entry_free);
+}
+
+/**
+ * gtd_task_aggregate_new:
+ *
+ * Creates a new, empty #GtdTaskAggregate.
+ *
+ * Returns: (transfer full): a new #GtdTaskAggregate
+ */
+GtdTaskAggregate*
+gtd_task_aggregate_new (void)
+{
+  return g_object_new (GTD_TYPE_TASK_AGGREGATE, NULL);
+}
+
+/**
+ * gtd_task_aggregate_add_list:
+ * @aggregate: a #GtdTaskAggregate
+ * @list: a #GtdTaskList
+ *
+ * Adds the tasks of @list to @aggregate, and keeps following
+ * the changes of @list. Emits ::task-added for every task
+ * of @list.
+ *
+ * Returns:
+ */
+void
+gtd_task_aggregate_add_list (GtdTaskAggregate *aggregate,
+                             GtdTaskList      *list)
+{
+  ListEntry *entry;
+  GList *tasks;
+  GList *l;
+
+  g_return_if_fail (GTD_IS_TASK_AGGREGATE (aggregate));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  if (gtd_task_aggregate__find_entry (aggregate, list))
+    return;
+
+  entry = g_new0 (ListEntry, 1);
+  entry->list = g_object_ref (list);
+  entry->tasks = g_ptr_array_new ();
+
+  tasks = gtd_task_list_get_tasks (list);
+
+  for (l = tasks; l != NULL; l = l->next)
+    g_ptr_array_add (entry->tasks, l->data);
+
+  g_ptr_array_sort (entry->tasks, gtd_task_aggregate__compare_tasks);
+
+  g_ptr_array_add (aggregate->priv->entries, entry);
+
+  g_signal_connect (list,
+                    "task-added",
+                    G_CALLBACK (gtd_task_aggregate__task_added),
+                    aggregate);
+  g_signal_connect (list,
+                    "task-removed",
+                    G_CALLBACK (gtd_task_aggregate__task_removed),
+                    aggregate);
+  g_signal_connect (list,
+                    "task-updated",
+                    G_CALLBACK (gtd_task_aggregate__task_updated),
+                    aggregate);
+
+  for (l = tasks; l != NULL; l = l->next)
+    g_signal_emit (aggregate, signals[TASK_ADDED], 0, l->data);
+
+  g_list_free (tasks);
+}
+
+/**
+ * gtd_task_aggregate_remove_list:
+ * @aggregate: a #GtdTaskAggregate
+ * @list: a #GtdTaskList
+ *
+ * Removes @list and its tasks from @aggregate. Emits ::task-removed
+ * for every task of @list.
+ *
+ * Returns:
+ */
+void
+gtd_task_aggregate_remove_list (GtdTaskAggregate *aggregate,
+                                GtdTaskList      *list)
+{
+  ListEntry *entry;
+  guint i;
+
+  g_return_if_fail (GTD_IS_TASK_AGGREGATE (aggregate));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  entry = gtd_task_aggregate__find_entry (aggregate, list);
+
+  if (!entry)
+    return;
+
+  g_signal_handlers_disconnect_by_data (list, aggregate);
+
+  for (i = 0; i < entry->tasks->len; i++)
+    g_signal_emit (aggregate, signals[TASK_REMOVED], 0, g_ptr_array_index (entry->tasks, i));
+
+  g_ptr_array_remove (aggregate->priv->entries, entry);
+}
+
+/**
+ * gtd_task_aggregate_get_lists:
+ * @aggregate: a #GtdTaskAggregate
+ *
+ * Retrieves the lists aggregated by @aggregate.
+ *
+ * Returns: (element-type GtdTaskList) (transfer container): the lists
+ * of @aggregate. Free with @g_list_free after use.
+ */
+GList*
+gtd_task_aggregate_get_lists (GtdTaskAggregate *aggregate)
+{
+  GPtrArray *entries;
+  GList *lists;
+  gint i;
+
+  g_return_val_if_fail (GTD_IS_TASK_AGGREGATE (aggregate), NULL);
+
+  entries = aggregate->priv->entries;
+  lists = NULL;
+
+  for (i = entries->len - 1; i >= 0; i--)
+    lists = g_list_prepend (lists, ((ListEntry*) g_ptr_array_index (entries, i))->list);
+
+  return lists;
+}
+
+/**
+ * gtd_task_aggregate_get_tasks:
+ * @aggregate: a #GtdTaskAggregate
+ *
+ * Retrieves the tasks of all the aggregated lists, sorted. The
+ * per-list orders are merged, so this costs O(n log k) for k lists
+ * instead of a full sort.
+ *
+ * Returns: (element-type GtdTask) (transfer container): the sorted
+ * tasks of @aggregate. Free with @g_list_free after use.
+ */
+GList*
+gtd_task_aggregate_get_tasks (GtdTaskAggregate *aggregate)
+{
+  GtdTaskAggregatePrivate *priv;
+  MergeCursor *heap;
+  GList *tasks;
+  guint n_cursors;
+  guint i;
+
+  g_return_val_if_fail (GTD_IS_TASK_AGGREGATE (aggregate), NULL);
+
+  priv = aggregate->priv;
+  heap = g_new0 (MergeCursor, priv->entries->len);
+  n_cursors = 0;
+  tasks = NULL;
+
+  /* One cursor per non-empty list */
+  for (i = 0; i < priv->entries->len; i++)
+    {
+      ListEntry *entry = g_ptr_array_index (priv->entries, i);
+
+      if (entry->tasks->len == 0)
+        continue;
+
+      heap[n_cursors].tasks = entry->tasks;
+      heap[n_cursors].position = 0;
+      n_cursors++;
+    }
+
+  for (i = n_cursors / 2; i > 0; i--)
+    gtd_task_aggregate__sift_down (heap, n_cursors, i - 1);
+
+  /* Repeatedly take the smallest head */
+  while (n_cursors > 0)
+    {
+      tasks = g_list_prepend (tasks, g_ptr_array_index (heap[0].tasks, heap[0].position));
+
+      heap[0].position++;
+
+      if (heap[0].position >= heap[0].tasks->len)
+        heap[0] = heap[--n_cursors];
+
+      gtd_task_aggregate__sift_down (heap, n_cursors, 0);
+    }
+
+  g_free (heap);
+
+  return g_list_reverse (tasks);
+}
@@ -0,0 +1,46 @@
+/* gtd-task-aggregate.h
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GTD_TASK_AGGREGATE_H
+#define GTD_TASK_AGGREGATE_H
+
+#include "gtd-types.h"
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define GTD_TYPE_TASK_AGGREGATE (gtd_task_aggregate_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdTaskAggregate, gtd_task_aggregate, GTD, TASK_AGGREGATE, GObject)
+
+GtdTaskAggregate*         gtd_task_aggregate_new                (void);
+
+void                      gtd_task_aggregate_add_list           (GtdTaskAggregate    *aggregate,
+                                                                 GtdTaskList         *list);
+
+void                      gtd_task_aggregate_remove_list        (GtdTaskAggregate    *aggregate,
+                                                                 GtdTaskList         *list);
+
+GList*                    gtd_task_aggregate_get_lists          (GtdTaskAggregate    *aggregate);
+
+GList*                    gtd_task_aggregate_get_tasks          (GtdTaskAggregate    *aggregate);
+
+G_END_DECLS
+
+#endif /* GTD_TASK_AGGREGATE_H */
@@ -0,0 +1,825 @@
+/* gtd-task-list-grid.c
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtd-task-list.h"
+#include "gtd-task-list-grid.h"
+#include "gtd-task-list-item.h"
+
+#include <glib/gi18n.h>
+#include <string.h>
+
+/*
+ * The lists of an origin, sorted by name. Only the items of the rows
+ * in or near the visible area exist; they are reused for other lists
+ * while scrolling, and the spacers stand in for the other rows.
+ */
+typedef struct
+{
+  GtdTaskList           *list;
+  gchar                 *name_key;
+} ListEntry;
+
+typedef struct
+{
+  gchar                 *origin;
+  gchar                 *origin_key;
+
+  /* ListEntry, sorted by name_key */
+  GPtrArray             *entries;
+
+  GtkWidget             *expander;
+  GtkWidget             *flowbox;
+  GtkWidget             *top_spacer;
+  GtkWidget             *bottom_spacer;
+
+  /* the entries bound to the items of the flowbox */
+  guint                  first;
+  guint                  n_items;
+  gint                   columns;
+} Section;
+
+typedef struct
+{
+  /* Section, sorted by origin_key */
+  GPtrArray             *sections;
+
+  GtkAdjustment         *vadjustment;
+  guint                  update_id;
+
+  /* the list under the pointer, until it's prefetched */
+  GtdTaskList           *hovered_list;
+  guint                  hover_timeout_id;
+
+  /* size of an item, spacing included */
+  gint                   item_width;
+  gint                   item_height;
+} GtdTaskListGridPrivate;
+
+struct _GtdTaskListGrid
+{
+  GtkBox                  parent;
+
+  /*<private>*/
+  GtdTaskListGridPrivate *priv;
+};
+
+/* Spacing between the items, and around the sections */
+#define ITEM_SPACING                             12
+
+/* Until an item is measured, assume the size of a thumbnail */
+#define DEFAULT_ITEM_SIZE                        (192 + ITEM_SPACING)
+
+/* Rows this close to the visible area have items too */
+#define VISIBILITY_MARGIN                        DEFAULT_ITEM_SIZE
+
+/* Moving the pointer across items on the way elsewhere isn't hovering */
+#define HOVER_DELAY                              250
+
+G_DEFINE_TYPE_WITH_PRIVATE (GtdTaskListGrid, gtd_task_list_grid, GTK_TYPE_BOX)
+
+enum {
+  LIST_HOVERED,
+  LIST_SELECTED,
+  NUM_SIGNALS
+};
+
+static guint signals[NUM_SIGNALS] = { 0, };
+
+static void          gtd_task_list_grid__queue_update            (GtdTaskListGrid    *grid);
+
+static void
+list_entry_free (ListEntry *entry)
+{
+  g_object_unref (entry->list);
+  g_free (entry->name_key);
+  g_free (entry);
+}
+
+static void
+section_free (Section *section)
+{
+  g_ptr_array_unref (section->entries);
+  g_free (section->origin);
+  g_free (section->origin_key);
+  g_free (section);
+}
+
+static gchar*
+gtd_task_list_grid__get_collation_key (const gchar *str)
+{
+  return g_utf8_collate_key (str ? str : "", -1);
+}
+
+static gint
+gtd_task_list_grid__compare_entries (gconstpointer a,
+                                     gconstpointer b)
+{
+  const ListEntry *e1 = *((ListEntry**) a);
+  const ListEntry *e2 = *((ListEntry**) b);
+
+  return strcmp (e1->name_key, e2->name_key);
+}
+
+static void
+gtd_task_list_grid__child_activated (GtkFlowBox      *flowbox,
+                                     GtdTaskListItem *item,
+                                     GtdTaskListGrid *grid)
+{
+  g_signal_emit (grid, signals[LIST_SELECTED], 0, gtd_task_list_item_get_list (item));
+}
+
+static gint
+gtd_task_list_grid__sort_func (GtkFlowBoxChild *a,
+                               GtkFlowBoxChild *b,
+                               gpointer         user_data)
+{
+  /* The position of the item's list in the visible range */
+  return GPOINTER_TO_INT (g_object_get_data (G_OBJECT (a), "position")) -
+         GPOINTER_TO_INT (g_object_get_data (G_OBJECT (b), "position"));
+}
+
+static void
+gtd_task_list_grid__cancel_hover (GtdTaskListGrid *grid)
+{
+  GtdTaskListGridPrivate *priv = grid->priv;
+
+  if (priv->hover_timeout_id > 0)
+    {
+      g_source_remove (priv->hover_timeout_id);
+      priv->hover_timeout_id = 0;
+    }
+
+  g_clear_object (&priv->hovered_list);
+}
+
+static gboolean
+gtd_task_list_grid__hover_timeout_cb (gpointer user_data)
+{
+  GtdTaskListGrid *grid = GTD_TASK_LIST_GRID (user_data);
+  GtdTaskListGridPrivate *priv = grid->priv;
+  GtdTaskList *list;
+
+  priv->hover_timeout_id = 0;
+
+  list = priv->hovered_list;
+  priv->hovered_list = NULL;
+
+  g_signal_emit (grid, signals[LIST_HOVERED], 0, list);
+
+  g_object_unref (list);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtd_task_list_grid__item_state_flags_changed (GtkWidget       *item,
+                                              GtkStateFlags    previous_flags,
+                                              GtdTaskListGrid *grid)
+{
+  GtdTaskListGridPrivate *priv = grid->priv;
+  GtdTaskList *list;
+  gboolean was_hovered;
+  gboolean hovered;
+
+  list = gtd_task_list_item_get_list (GTD_TASK_LIST_ITEM (item));
+  was_hovered = previous_flags & GTK_STATE_FLAG_PRELIGHT;
+  hovered = gtk_widget_get_state_flags (item) & GTK_STATE_FLAG_PRELIGHT;
+
+  if (hovered == was_hovered || !list)
+    return;
+
+  if (hovered)
+    {
+      gtd_task_list_grid__cancel_hover (grid);
+
+      priv->hovered_list = g_object_ref (list);
+      priv->hover_timeout_id = g_timeout_add (HOVER_DELAY, gtd_task_list_grid__hover_timeout_cb, grid);
+    }
+  else if (priv->hovered_list == list)
+    {
+      gtd_task_list_grid__cancel_hover (grid);
+    }
+}
+
+static void
+gtd_task_list_grid__update_section (GtdTaskListGrid *grid,
+                                    Section         *section,
+                                    GtkWidget       *scrolled_window)
+{
+  GtdTaskListGridPrivate *priv = grid->priv;
+  GHashTable *in_range;
+  GHashTable *bound;
+  GtkWidget *item;
+  gboolean reordered;
+  GList *children;
+  GList *unbound;
+  GList *l;
+  gint first_row;
+  gint last_row;
+  gint columns;
+  gint width;
+  gint n_rows;
+  guint n_items;
+  guint first;
+  guint i;
+  gint y;
+
+  /*
+   * The flowbox only gets as wide as its items need, so the room comes from
+   * the grid, less the border of the section.
+   */
+  width = gtk_widget_get_allocated_width (GTK_WIDGET (grid)) - 2 * ITEM_SPACING;
+  columns = MAX (1, (width + ITEM_SPACING) / priv->item_width);
+  n_rows = (section->entries->len + columns - 1) / columns;
+
+  /* Find the rows in or near the visible area */
+  if (!gtk_expander_get_expanded (GTK_EXPANDER (section->expander)) || n_rows == 0)
+    {
+      first_row = 0;
+      last_row = -1;
+    }
+  else if (!scrolled_window ||
+           !gtk_widget_get_realized (section->top_spacer) ||
+           !gtk_widget_translate_coordinates (section->top_spacer, scrolled_window, 0, 0, NULL, &y))
+    {
+      /* Not shown yet, so only fill the first screen */
+      first_row = 0;
+      last_row = MIN (n_rows, 1 + 2 * VISIBILITY_MARGIN / priv->item_height) - 1;
+    }
+  else
+    {
+      first_row = (-y - VISIBILITY_MARGIN) / priv->item_height;
+      last_row = (gtk_widget_get_allocated_height (scrolled_window) - y + VISIBILITY_MARGIN) / priv->item_height;
+
+      first_row = CLAMP (first_row, 0, n_rows);
+      last_row = CLAMP (last_row, -1, n_rows - 1);
+    }
+
+  if (last_row < first_row)
+    {
+      first_row = 0;
+      last_row = -1;
+    }
+
+  first = first_row * columns;
+  n_items = MIN (section->entries->len - first, (guint) (last_row - first_row + 1) * columns);
+
+  if (section->columns != columns)
+    {
+      /* Only the maximum, or the overview could never get narrower again */
+      gtk_flow_box_set_max_children_per_line (GTK_FLOW_BOX (section->flowbox), columns);
+      section->columns = columns;
+    }
+
+  /* Items keep their lists while they stay in range, so they keep their thumbnails */
+  in_range = g_hash_table_new (g_direct_hash, g_direct_equal);
+  bound = g_hash_table_new (g_direct_hash, g_direct_equal);
+  unbound = NULL;
+
+  for (i = 0; i < n_items; i++)
+    {
+      ListEntry *entry = g_ptr_array_index (section->entries, first + i);
+
+      g_hash_table_add (in_range, entry->list);
+    }
+
+  children = gtk_container_get_children (GTK_CONTAINER (section->flowbox));
+
+  for (l = children; l != NULL; l = l->next)
+    {
+      GtdTaskList *list = gtd_task_list_item_get_list (l->data);
+
+      if (list && g_hash_table_contains (in_range, list) && !g_hash_table_contains (bound, list))
+        g_hash_table_insert (bound, list, l->data);
+      else
+        unbound = g_list_prepend (unbound, l->data);
+    }
+
+  g_list_free (children);
+
+  /* Rebind the other items to the lists that entered the range */
+  reordered = FALSE;
+
+  for (i = 0; i < n_items; i++)
+    {
+      ListEntry *entry = g_ptr_array_index (section->entries, first + i);
+
+      item = g_hash_table_lookup (bound, entry->list);
+
+      if (!item && unbound)
+        {
+          item = unbound->data;
+          unbound = g_list_delete_link (unbound, unbound);
+
+          gtd_task_list_item_set_list (GTD_TASK_LIST_ITEM (item), entry->list);
+        }
+      else if (!item)
+        {
+          item = gtd_task_list_item_new (entry->list);
+          gtk_widget_show (item);
+
+          g_signal_connect (item,
+                            "state-flags-changed",
+                            G_CALLBACK (gtd_task_list_grid__item_state_flags_changed),
+                            grid);
+
+          gtk_flow_box_insert (GTK_FLOW_BOX (section->flowbox), item, -1);
+        }
+
+      if (GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (item), "position")) != i + 1)
+        {
+          g_object_set_data (G_OBJECT (item), "position", GUINT_TO_POINTER (i + 1));
+          reordered = TRUE;
+        }
+    }
+
+  /* Items that aren't needed anymore */
+  for (l = unbound; l != NULL; l = l->next)
+    gtk_widget_destroy (l->data);
+
+  if (reordered)
+    gtk_flow_box_invalidate_sort (GTK_FLOW_BOX (section->flowbox));
+
+  section->n_items = n_items;
+
+  g_hash_table_destroy (in_range);
+  g_hash_table_destroy (bound);
+  g_list_free (unbound);
+
+  section->first = first;
+
+  /* Measure an item once, now that there's one */
+  if (n_items > 0 && priv->item_width == DEFAULT_ITEM_SIZE && priv->item_height == DEFAULT_ITEM_SIZE)
+    {
+      gint width;
+      gint height;
+
+      item = GTK_WIDGET (gtk_flow_box_get_child_at_index (GTK_FLOW_BOX (section->flowbox), 0));
+
+      gtk_widget_get_preferred_width (item, NULL, &width);
+      gtk_widget_get_preferred_height (item, NULL, &height);
+
+      if (width + ITEM_SPACING != priv->item_width || height + ITEM_SPACING != priv->item_height)
+        {
+          priv->item_width = MAX (width + ITEM_SPACING, 1);
+          priv->item_height = MAX (height + ITEM_SPACING, 1);
+
+          gtd_task_list_grid__queue_update (grid);
+        }
+    }
+
+  gtk_widget_set_size_request (section->top_spacer,
+                               -1,
+                               first_row * priv->item_height);
+  gtk_widget_set_size_request (section->bottom_spacer,
+                               -1,
+                               last_row < 0 ? n_rows * priv->item_height : (n_rows - last_row - 1) * priv->item_height);
+}
+
+static void
+gtd_task_list_grid__update (GtdTaskListGrid *grid)
+{
+  GtdTaskListGridPrivate *priv = grid->priv;
+  GtkWidget *scrolled_window;
+  guint i;
+
+  scrolled_window = gtk_widget_get_ancestor (GTK_WIDGET (grid), GTK_TYPE_SCROLLED_WINDOW);
+
+  for (i = 0; i < priv->sections->len; i++)
+    gtd_task_list_grid__update_section (grid, g_ptr_array_index (priv->sections, i), scrolled_window);
+}
+
+static gboolean
+gtd_task_list_grid__update_cb (gpointer user_data)
+{
+  GtdTaskListGrid *grid = GTD_TASK_LIST_GRID (user_data);
+
+  grid->priv->update_id = 0;
+
+  gtd_task_list_grid__update (grid);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtd_task_list_grid__queue_update (GtdTaskListGrid *grid)
+{
+  GtdTaskListGridPrivate *priv = grid->priv;
+
+  if (priv->update_id == 0)
+    priv->update_id = g_idle_add (gtd_task_list_grid__update_cb, grid);
+}
+
+static void
+gtd_task_list_grid__adjustment_changed (GtdTaskListGrid *grid)
+{
+  /* Scrolling must not lag behind, so update right away */
+  gtd_task_list_grid__update (grid);
+}
+
+static Section*
+gtd_task_list_grid__get_section (GtdTaskListGrid *grid,
+                                 const gchar     *origin,
+                                 gboolean         create)
+{
+  GtdTaskListGridPrivate *priv = grid->priv;
+  Section *section;
+  GtkWidget *box;
+  gchar *markup;
+  guint i;
+
+  for (i = 0; i < priv->sections->len; i++)
+    {
+      section = g_ptr_array_index (priv->sections, i);
+
+      if (g_strcmp0 (section->origin, origin) == 0)
+        return section;
+    }
+
+  if (!create)
+    return NULL;
+
+  section = g_new0 (Section, 1);
+  section->origin = g_strdup (origin);
+  section->origin_key = gtd_task_list_grid__get_collation_key (origin);
+  section->entries = g_ptr_array_new_with_free_func ((GDestroyNotify) list_entry_free);
+
+  /* Header */
+  markup = g_markup_printf_escaped ("<b>%s</b>", origin ? origin : "");
+
+  section->expander = gtk_expander_new (markup);
+  gtk_expander_set_use_markup (GTK_EXPANDER (section->expander), TRUE);
+  gtk_expander_set_expanded (GTK_EXPANDER (section->expander), TRUE);
+  gtk_container_set_border_width (GTK_CONTAINER (section->expander), ITEM_SPACING);
+
+  g_signal_connect_swapped (section->expander,
+                            "notify::expanded",
+                            G_CALLBACK (gtd_task_list_grid__queue_update),
+                            grid);
+
+  g_free (markup);
+
+  /* Items, with the spacers of the rows without items */
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  gtk_widget_set_margin_top (box, ITEM_SPACING);
+
+  section->top_spacer = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  section->bottom_spacer = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+
+  section->flowbox = gtk_flow_box_new ();
+  gtk_flow_box_set_homogeneous (GTK_FLOW_BOX (section->flowbox), TRUE);
+  gtk_flow_box_set_column_spacing (GTK_FLOW_BOX (section->flowbox), ITEM_SPACING);
+  gtk_flow_box_set_row_spacing (GTK_FLOW_BOX (section->flowbox), ITEM_SPACING);
+  gtk_flow_box_set_selection_mode (GTK_FLOW_BOX (section->flowbox), GTK_SELECTION_NONE);
+  gtk_widget_set_valign (section->flowbox, GTK_ALIGN_START);
+  gtk_flow_box_set_sort_func (GTK_FLOW_BOX (section->flowbox),
+                              gtd_task_list_grid__sort_func,
+                              NULL,
+                              NULL);
+
+  g_signal_connect (section->flowbox,
+                    "child-activated",
+                    G_CALLBACK (gtd_task_list_grid__child_activated),
+                    grid);
+
+  gtk_container_add (GTK_CONTAINER (box), section->top_spacer);
+  gtk_container_add (GTK_CONTAINER (box), section->flowbox);
+  gtk_container_add (GTK_CONTAINER (box), section->bottom_spacer);
+  gtk_container_add (GTK_CONTAINER (section->expander), box);
+
+  gtk_widget_show_all (section->expander);
+
+  /* Keep the sections sorted by origin */
+  for (i = 0; i < priv->sections->len; i++)
+    {
+      Section *aux = g_ptr_array_index (priv->sections, i);
+
+      if (strcmp (section->origin_key, aux->origin_key) < 0)
+        break;
+    }
+
+  g_ptr_array_insert (priv->sections, i, section);
+
+  gtk_container_add (GTK_CONTAINER (grid), section->expander);
+  gtk_box_reorder_child (GTK_BOX (grid), section->expander, i);
+
+  return section;
+}
+
+static void
+gtd_task_list_grid__remove_section (GtdTaskListGrid *grid,
+                                    Section         *section)
+{
+  gtk_widget_destroy (section->expander);
+
+  g_ptr_array_remove (grid->priv->sections, section);
+}
+
+static void
+gtd_task_list_grid__list_name_changed (GtdTaskList     *list,
+                                       GParamSpec      *pspec,
+                                       GtdTaskListGrid *grid)
+{
+  Section *section;
+  guint i;
+
+  section = gtd_task_list_grid__get_section (grid, gtd_task_list_get_origin (list), FALSE);
+
+  if (!section)
+    return;
+
+  for (i = 0; i < section->entries->len; i++)
+    {
+      ListEntry *entry = g_ptr_array_index (section->entries, i);
+
+      if (entry->list != list)
+        continue;
+
+      g_free (entry->name_key);
+      entry->name_key = gtd_task_list_grid__get_collation_key (gtd_task_list_get_name (list));
+      break;
+    }
+
+  g_ptr_array_sort (section->entries, gtd_task_list_grid__compare_entries);
+
+  gtd_task_list_grid__queue_update (grid);
+}
+
+static void
+gtd_task_list_grid_finalize (GObject *object)
+{
+  GtdTaskListGrid *self = (GtdTaskListGrid *)object;
+  GtdTaskListGridPrivate *priv = gtd_task_list_grid_get_instance_private (self);
+
+  g_clear_pointer (&priv->sections, g_ptr_array_unref);
+
+  G_OBJECT_CLASS (gtd_task_list_grid_parent_class)->finalize (object);
+}
+
+static void
+gtd_task_list_grid_dispose (GObject *object)
+{
+  GtdTaskListGrid *self = GTD_TASK_LIST_GRID (object);
+  GtdTaskListGridPrivate *priv = self->priv;
+  guint i;
+
+  if (priv->update_id > 0)
+    {
+      g_source_remove (priv->update_id);
+      priv->update_id = 0;
+    }
+
+  gtd_task_list_grid__cancel_hover (self);
+
+  if (priv->vadjustment)
+    {
+      g_signal_handlers_disconnect_by_data (priv->vadjustment, self);
+      g_clear_object (&priv->vadjustment);
+    }
+
+  for (i = 0; priv->sections && i < priv->sections->len; i++)
+    {
+      Section *section = g_ptr_array_index (priv->sections, i);
+      guint j;
+
+      for (j = 0; j < section->entries->len; j++)
+        {
+          ListEntry *entry = g_ptr_array_index (section->entries, j);
+
+          g_signal_handlers_disconnect_by_data (entry->list, self);
+        }
+    }
+
+  G_OBJECT_CLASS (gtd_task_list_grid_parent_class)->dispose (object);
+}
+
+static void
+gtd_task_list_grid_size_allocate (GtkWidget     *widget,
+                                  GtkAllocation *allocation)
+{
+  GTK_WIDGET_CLASS (gtd_task_list_grid_parent_class)->size_allocate (widget, allocation);
+
+  /* The number of columns may have changed */
+  gtd_task_list_grid__queue_update (GTD_TASK_LIST_GRID (widget));
+}
+
+static void
+gtd_task_list_grid_hierarchy_changed (GtkWidget *widget,
+                                      GtkWidget *previous_toplevel)
+{
+  GtdTaskListGridPrivate *priv = GTD_TASK_LIST_GRID (widget)->priv;
+  GtkWidget *scrolled_window;
+
+  if (GTK_WIDGET_CLASS (gtd_task_list_grid_parent_class)->hierarchy_changed)
+    GTK_WIDGET_CLASS (gtd_task_list_grid_parent_class)->hierarchy_changed (widget, previous_toplevel);
+
+  /* Follow the scrolling of the overview */
+  if (priv->vadjustment)
+    {
+      g_signal_handlers_disconnect_by_data (priv->vadjustment, widget);
+      g_clear_object (&priv->vadjustment);
+    }
+
+  scrolled_window = gtk_widget_get_ancestor (widget, GTK_TYPE_SCROLLED_WINDOW);
+
+  if (scrolled_window)
+    {
+      priv->vadjustment = g_object_ref (gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled_window)));
+
+      g_signal_connect_swapped (priv->vadjustment,
+                                "value-changed",
+                                G_CALLBACK (gtd_task_list_grid__adjustment_changed),
+                                widget);
+      g_signal_connect_swapped (priv->vadjustment,
+                                "changed",
+                                G_CALLBACK (gtd_task_list_grid__queue_update),
+                                widget);
+    }
+
+  gtd_task_list_grid__queue_update (GTD_TASK_LIST_GRID (widget));
+}
+
+static void
+gtd_task_list_grid_class_init (GtdTaskListGridClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
+
+  object_class->dispose = gtd_task_list_grid_dispose;
+  object_class->finalize = gtd_task_list_grid_finalize;
+
+  widget_class->hierarchy_changed = gtd_task_list_grid_hierarchy_changed;
+  widget_class->size_allocate = gtd_task_list_grid_size_allocate;
+
+  /**
+   * GtdTaskListGrid::list-hovered:
+   *
+   * The ::list-hovered signal is emmited after the pointer rests on
+   * the item of a #GtdTaskList, so its tasks can be fetched before
+   * it's opened.
+   */
+  signals[LIST_HOVERED] = g_signal_new ("list-hovered",
+                                        GTD_TYPE_TASK_LIST_GRID,
+                                        G_SIGNAL_RUN_LAST,
+                                        0,
+                                        NULL,
+                                        NULL,
+                                        NULL,
+                                        G_TYPE_NONE,
+                                        1,
+                                        GTD_TYPE_TASK_LIST);
+
+  /**
+   * GtdTaskListGrid::list-selected:
+   *
+   * The ::list-selected signal is emmited after the item of a
+   * #GtdTaskList is activated.
+   */
+  signals[LIST_SELECTED] = g_signal_new ("list-selected",
+                                         GTD_TYPE_TASK_LIST_GRID,
+                                         G_SIGNAL_RUN_LAST,
+                                         0,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         G_TYPE_NONE,
+                                         1,
+                                         GTD_TYPE_TASK_LIST);
+}
+
+static void
+gtd_task_list_grid_init (GtdTaskListGrid *self)
+{
+  self->priv = gtd_task_list_grid_get_instance_private (self);
+  self->priv->sections = g_ptr_array_new_with_free_func ((GDestroyNotify) section_free);
+  self->priv->item_width = DEFAULT_ITEM_SIZE;
+  self->priv->item_height = DEFAULT_ITEM_SIZE;
+
+  gtk_orientable_set_orientation (GTK_ORIENTABLE (self), GTK_ORIENTATION_VERTICAL);
+}
+
+/**
+ * gtd_task_list_grid_new:
+ *
+ * Creates a new #GtdTaskListGrid.
+ *
+ * Returns: (transfer full): a new #GtdTaskListGrid
+ */
+GtkWidget*
+gtd_task_list_grid_new (void)
+{
+  return g_object_new (GTD_TYPE_TASK_LIST_GRID, NULL);
+}
+
+/**
+ * gtd_task_list_grid_add_list:
+ * @grid: a #GtdTaskListGrid
+ * @list: a #GtdTaskList
+ *
+ * Adds @list to the section of its origin, sorted by name.
+ *
+ * Returns:
+ */
+void
+gtd_task_list_grid_add_list (GtdTaskListGrid *grid,
+                             GtdTaskList     *list)
+{
+  ListEntry *entry;
+  Section *section;
+  guint low;
+  guint high;
+
+  g_return_if_fail (GTD_IS_TASK_LIST_GRID (grid));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  section = gtd_task_list_grid__get_section (grid, gtd_task_list_get_origin (list), TRUE);
+
+  entry = g_new0 (ListEntry, 1);
+  entry->list = g_object_ref (list);
+  entry->name_key = gtd_task_list_grid__get_collation_key (gtd_task_list_get_name (list));
+
+  /* Find the sorted position of the list */
+  low = 0;
+  high = section->entries->len;
+
+  while (low < high)
+    {
+      guint middle = (low + high) / 2;
+      ListEntry *aux = g_ptr_array_index (section->entries, middle);
+
+      if (strcmp (aux->name_key, entry->name_key) <= 0)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+  g_ptr_array_insert (section->entries, low, entry);
+
+  g_signal_connect (list,
+                    "notify::name",
+                    G_CALLBACK (gtd_task_list_grid__list_name_changed),
+                    grid);
+
+  gtd_task_list_grid__queue_update (grid);
+}
+
+/**
+ * gtd_task_list_grid_remove_list:
+ * @grid: a #GtdTaskListGrid
+ * @list: a #GtdTaskList
+ *
+ * Removes @list from @grid. Empty sections are removed too.
+ *
+ * Returns:
+ */
+void
+gtd_task_list_grid_remove_list (GtdTaskListGrid *grid,
+                                GtdTaskList     *list)
+{
+  Section *section;
+  guint i;
+
+  g_return_if_fail (GTD_IS_TASK_LIST_GRID (grid));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  section = gtd_task_list_grid__get_section (grid, gtd_task_list_get_origin (list), FALSE);
+
+  if (!section)
+    return;
+
+  if (grid->priv->hovered_list == list)
+    gtd_task_list_grid__cancel_hover (grid);
+
+  g_signal_handlers_disconnect_by_data (list, grid);
+
+  for (i = 0; i < section->entries->len; i++)
+    {
+      ListEntry *entry = g_ptr_array_index (section->entries, i);
+
+      if (entry->list == list)
+        {
+          g_ptr_array_remove_index (section->entries, i);
+          break;
+        }
+    }
+
+  if (section->entries->len == 0)
+    gtd_task_list_grid__remove_section (grid, section);
+  else
+    gtd_task_list_grid__update (grid);
+}
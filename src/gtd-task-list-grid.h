@@ -0,0 +1,42 @@
+/* gtd-task-list-grid.h
+ *
+ * Copyright (C) 2015 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GTD_TASK_LIST_GRID_H
+#define GTD_TASK_LIST_GRID_H
+
+#include "gtd-types.h"
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define GTD_TYPE_TASK_LIST_GRID (gtd_task_list_grid_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdTaskListGrid, gtd_task_list_grid, GTD, TASK_LIST_GRID, GtkBox)
+
+GtkWidget*              gtd_task_list_grid_new                (void);
+
+void                    gtd_task_list_grid_add_list           (GtdTaskListGrid      *grid,
+                                                               GtdTaskList          *list);
+
+void                    gtd_task_list_grid_remove_list        (GtdTaskListGrid      *grid,
+                                                               GtdTaskList          *list);
+
+G_END_DECLS
+
+#endif /* GTD_TASK_LIST_GRID_H */
@@ -21,6 +21,7 @@
 #include "gtd-task-list-item.h"
 
 #include <glib/gi18n.h>
+#include <string.h>
 
 typedef struct
 {
@@ -33,6 +34,27 @@ typedef struct
   /* data */
   GtdTaskList               *list;
   GtdWindowMode              mode;
+  GSList                    *bindings;
+
+  /*
+   * the first tasks of the list, plus the one after them, of which
+   * only the first thumbnail_rows are drawn; and whether it's full
+   */
+  GPtrArray                 *thumbnail_tasks;
+  guint                      thumbnail_rows;
+  gboolean                   thumbnail_full;
+  gboolean                   thumbnail_manual_order;
+  guint                      thumbnail_tick_id;
+  GCancellable              *thumbnail_cancellable;
+
+  /* thumbnails are only rendered near the visible area */
+  GtkAdjustment             *vadjustment;
+  gboolean                   thumbnail_dirty;
+  gboolean                   thumbnail_visible;
+
+  /* hash of the shown thumbnail, and the one cached on disk */
+  gchar                     *thumbnail_hash;
+  GdkPixbuf                 *cached_thumbnail;
 
 } GtdTaskListItemPrivate;
 
@@ -50,6 +72,14 @@ G_DEFINE_TYPE_WITH_PRIVATE (GtdTaskListItem, gtd_task_list_item, GTK_TYPE_FLOW_B
 
 #define THUMBNAIL_SIZE            192
 
+/* Items this close to the visible area render their thumbnails too */
+#define VISIBILITY_MARGIN         THUMBNAIL_SIZE
+
+/* Options of the thumbnails cached on disk */
+#define HASH_OPTION               "tEXt::X-GNOME-Todo-Hash"
+#define ROWS_OPTION               "tEXt::X-GNOME-Todo-Rows"
+#define FULL_OPTION               "tEXt::X-GNOME-Todo-Full"
+
 enum {
   PROP_0,
   PROP_MODE,
@@ -57,62 +87,278 @@ enum {
   LAST_PROP
 };
 
-GdkPixbuf*
-gtd_task_list_item__render_thumbnail (GtdTaskListItem *item)
+/*
+ * The rasterized background of the thumbnails, shared by all the
+ * items: size → cairo_surface_t, for backgrounds_scale only.
+ */
+static GHashTable       *backgrounds = NULL;
+static gint              backgrounds_scale = 0;
+
+static void
+gtd_task_list_item__clear_backgrounds (void)
+{
+  g_hash_table_remove_all (backgrounds);
+}
+
+static cairo_surface_t*
+gtd_task_list_item__get_background (gint size,
+                                    gint scale)
 {
-  PangoFontDescription *font_desc;
-  GtkStyleContext *context;
   cairo_surface_t *surface;
-  GtkStateFlags state;
-  PangoLayout *layout;
-  GtdTaskList *list;
-  GdkPixbuf *pix = NULL;
-  GdkPixbuf *thumbnail;
-  GtkBorder margin;
-  GtkBorder padding;
-  GdkRGBA *color;
-  cairo_t *cr;
+  GdkPixbuf *pixbuf;
   GError *error = NULL;
-  GList *tasks;
 
-  /* TODO: review size here, maybe not hardcoded */
-  list = item->priv->list;
-  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
-                                        THUMBNAIL_SIZE,
-                                        THUMBNAIL_SIZE);
-  cr = cairo_create (surface);
+  if (!backgrounds)
+    {
+      backgrounds = g_hash_table_new_full (g_direct_hash,
+                                           g_direct_equal,
+                                           NULL,
+                                           (GDestroyNotify) cairo_surface_destroy);
+
+      g_signal_connect (gtk_settings_get_default (),
+                        "notify::gtk-theme-name",
+                        G_CALLBACK (gtd_task_list_item__clear_backgrounds),
+                        NULL);
+    }
 
-  /*
-   * We'll draw the task names according to the font size, margin & padding
-   * specified by the .thumbnail class. With that, it can be adapted to any
-   * other themes.
-   */
-  context = gtk_widget_get_style_context (GTK_WIDGET (item));
-  state = gtk_widget_get_state_flags (GTK_WIDGET (item));
+  /* Backgrounds of the previous scale factor are useless now */
+  if (backgrounds_scale != scale)
+    {
+      gtd_task_list_item__clear_backgrounds ();
+      backgrounds_scale = scale;
+    }
 
-  gtk_style_context_save (context);
-  gtk_style_context_add_class (context, "thumbnail");
+  surface = g_hash_table_lookup (backgrounds, GINT_TO_POINTER (size));
 
-  /* Draw the thumbnail image */
-  thumbnail = gdk_pixbuf_new_from_resource ("/org/gnome/todo/theme/bg.svg", &error);
+  if (surface)
+    return surface;
+
+  pixbuf = gdk_pixbuf_new_from_resource_at_scale ("/org/gnome/todo/theme/bg.svg",
+                                                  size * scale,
+                                                  size * scale,
+                                                  TRUE,
+                                                  &error);
 
   if (error)
     {
       g_warning ("Error loading thumbnail: %s", error->message);
       g_error_free (error);
-      goto out;
+      return NULL;
     }
 
-  gtk_render_icon (context,
-                   cr,
-                   thumbnail,
-                   0.0,
-                   0.0);
+  surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, scale, NULL);
+  g_hash_table_insert (backgrounds, GINT_TO_POINTER (size), surface);
 
-  /* Draw the list's background color */
-  color = gtd_task_list_get_color (list);
+  g_object_unref (pixbuf);
+
+  return surface;
+}
+
+/*
+ * An immutable snapshot of everything needed to render a thumbnail,
+ * so that it can be rendered in a worker thread. The rendered rows
+ * are written back to n_rows and full, and the thumbnail is saved
+ * to path.
+ */
+typedef struct
+{
+  gchar                     *path;
+  gchar                     *hash;
+  gint                       scale;
+  cairo_surface_t           *background;
+  PangoFontDescription      *font_desc;
+  GtkBorder                  margin;
+  GtkBorder                  padding;
+  GdkRGBA                    color;
+  GdkRGBA                    text_color;
+  gchar                    **titles;
+
+  /* results */
+  guint                      n_rows;
+  gboolean                   full;
+} ThumbnailData;
+
+static void
+thumbnail_data_free (ThumbnailData *data)
+{
+  g_free (data->path);
+  g_free (data->hash);
+  cairo_surface_destroy (data->background);
+  pango_font_description_free (data->font_desc);
+  g_strfreev (data->titles);
+  g_free (data);
+}
+
+static gchar*
+gtd_task_list_item__get_cache_path (GtdTaskList *list)
+{
+  gchar *filename;
+  gchar *path;
+
+  filename = g_strdup_printf ("%s.png", gtd_object_get_uid (GTD_OBJECT (list)));
+  path = g_build_filename (g_get_user_cache_dir (), "gnome-todo", "thumbnails", filename, NULL);
+
+  g_free (filename);
 
-  gdk_cairo_set_source_rgba (cr, color);
+  return path;
+}
+
+/*
+ * Hashes everything that changes how the thumbnail looks, so that
+ * identical thumbnails are never rendered twice.
+ */
+static gchar*
+gtd_task_list_item__compute_hash (ThumbnailData *data)
+{
+  GChecksum *checksum;
+  gchar *font;
+  gchar *hash;
+  gchar *metrics;
+  guint i;
+
+  font = pango_font_description_to_string (data->font_desc);
+  metrics = g_strdup_printf ("%d %d %d %d %d %d %d %d %d %d %f %f %f %f %f %f %f %f",
+                             THUMBNAIL_SIZE,
+                             data->scale,
+                             data->margin.left,
+                             data->margin.right,
+                             data->margin.top,
+                             data->margin.bottom,
+                             data->padding.left,
+                             data->padding.right,
+                             data->padding.top,
+                             data->padding.bottom,
+                             data->color.red,
+                             data->color.green,
+                             data->color.blue,
+                             data->color.alpha,
+                             data->text_color.red,
+                             data->text_color.green,
+                             data->text_color.blue,
+                             data->text_color.alpha);
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA1);
+
+  g_checksum_update (checksum, (const guchar*) font, strlen (font) + 1);
+  g_checksum_update (checksum, (const guchar*) metrics, strlen (metrics) + 1);
+
+  for (i = 0; data->titles[i] != NULL; i++)
+    g_checksum_update (checksum, (const guchar*) data->titles[i], strlen (data->titles[i]) + 1);
+
+  hash = g_strdup (g_checksum_get_string (checksum));
+
+  g_checksum_free (checksum);
+  g_free (metrics);
+  g_free (font);
+
+  return hash;
+}
+
+/*
+ * Stores @surface in the thumbnail cache, along with the hash and rows
+ * of @data. Runs in a worker thread.
+ */
+static void
+gtd_task_list_item__save_thumbnail (ThumbnailData   *data,
+                                    cairo_surface_t *surface)
+{
+  GdkPixbuf *pix;
+  gchar *buffer;
+  gchar *dirname;
+  gchar *rows;
+  gsize size;
+  GError *error = NULL;
+
+  dirname = g_path_get_dirname (data->path);
+  rows = g_strdup_printf ("%u", data->n_rows);
+
+  pix = gdk_pixbuf_get_from_surface (surface,
+                                     0,
+                                     0,
+                                     THUMBNAIL_SIZE * data->scale,
+                                     THUMBNAIL_SIZE * data->scale);
+
+  g_mkdir_with_parents (dirname, 0700);
+
+  if (gdk_pixbuf_save_to_buffer (pix,
+                                 &buffer,
+                                 &size,
+                                 "png",
+                                 &error,
+                                 HASH_OPTION, data->hash,
+                                 ROWS_OPTION, rows,
+                                 FULL_OPTION, data->full ? "1" : "0",
+                                 NULL))
+    {
+      g_file_set_contents (data->path, buffer, size, &error);
+      g_free (buffer);
+    }
+
+  if (error)
+    {
+      g_warning ("%s: %s: %s", G_STRFUNC, _("Error saving thumbnail"), error->message);
+      g_error_free (error);
+    }
+
+  g_object_unref (pix);
+  g_free (rows);
+  g_free (dirname);
+}
+
+/*
+ * Retrieves how many task titles fit in the thumbnail, following
+ * the same layout rules as gtd_task_list_item__render_thumbnail().
+ */
+static guint
+gtd_task_list_item__get_n_rows (PangoLayout *layout,
+                                GtkBorder   *margin,
+                                GtkBorder   *padding)
+{
+  gint font_height;
+  gdouble y;
+  guint n_rows;
+
+  pango_layout_set_text (layout, "X", -1);
+  pango_layout_get_pixel_size (layout, NULL, &font_height);
+
+  font_height = MAX (font_height, 1);
+  n_rows = 0;
+  y = 9.0 + margin->top + padding->top;
+
+  while (y + (padding->top + font_height + padding->bottom) + margin->bottom <= 174)
+    {
+      y += font_height + padding->bottom + padding->top;
+      n_rows++;
+    }
+
+  return n_rows;
+}
+
+/*
+ * Renders the thumbnail described by @data, at its scale factor. This
+ * runs in a worker thread, so it must only use cairo and Pango, and
+ * never touch the item, the list or its tasks.
+ */
+static cairo_surface_t*
+gtd_task_list_item__render_thumbnail (ThumbnailData *data)
+{
+  cairo_surface_t *surface;
+  PangoLayout *layout;
+  cairo_t *cr;
+
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                        THUMBNAIL_SIZE * data->scale,
+                                        THUMBNAIL_SIZE * data->scale);
+  cairo_surface_set_device_scale (surface, data->scale, data->scale);
+
+  cr = cairo_create (surface);
+
+  /* Draw the thumbnail image */
+  cairo_set_source_surface (cr, data->background, 0.0, 0.0);
+  cairo_paint (cr);
+
+  /* Draw the list's background color */
+  gdk_cairo_set_source_rgba (cr, &data->color);
 
   cairo_rectangle (cr,
                    33.0,
@@ -122,58 +368,36 @@ gtd_task_list_item__render_thumbnail (GtdTaskListItem *item)
 
   cairo_fill (cr);
 
-  /* Draw the first tasks from the list */
-  gtk_style_context_get (context,
-                         state,
-                         "font", &font_desc,
-                         NULL);
-  gtk_style_context_get_margin (context,
-                                state,
-                                &margin);
-  gtk_style_context_get_padding (context,
-                                 state,
-                                 &padding);
-
-  layout = pango_cairo_create_layout (cr);
-  tasks = gtd_task_list_get_tasks (list);
-
   /*
-   * Sort the list, so that the first tasks are similar to what
-   * the user will see when selecting the list.
+   * We'll draw the task names according to the font size, margin & padding
+   * specified by the .thumbnail class. With that, it can be adapted to any
+   * other themes.
    */
-  tasks = g_list_sort (tasks, (GCompareFunc) gtd_task_compare);
+  layout = pango_cairo_create_layout (cr);
 
-  pango_layout_set_font_description (layout, font_desc);
+  pango_layout_set_font_description (layout, data->font_desc);
   pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_END);
-  pango_layout_set_width (layout, (126 - margin.left - margin.right) * PANGO_SCALE);
+  pango_layout_set_width (layout, (126 - data->margin.left - data->margin.right) * PANGO_SCALE);
 
-  /*
-   * If the list exists and it's first element is a completed task,
-   * we know for sure (since the list is already sorted) that there's
-   * no undone tasks here.
-   */
-  if (!tasks ||
-      (tasks && !gtd_task_get_complete (tasks->data)))
+  gdk_cairo_set_source_rgba (cr, &data->text_color);
+
+  if (data->titles[0])
     {
       /* Draw the task name for each selected row. */
       gdouble x, y;
-      GList *l;
+      guint i;
 
-      x = 33.0 + margin.left;
-      y = 9.0 + margin.top;
+      x = 33.0 + data->margin.left;
+      y = 9.0 + data->margin.top;
 
-      for (l = tasks; l != NULL; l = l->next)
+      for (i = 0; data->titles[i] != NULL; i++)
         {
           gint font_height;
 
-          /* Don't render completed tasks */
-          if (gtd_task_get_complete (l->data))
-            continue;
-
-          y += padding.top;
+          y += data->padding.top;
 
           pango_layout_set_text (layout,
-                                 gtd_task_get_title (l->data),
+                                 data->titles[i],
                                  -1);
 
           pango_layout_get_pixel_size (layout,
@@ -184,30 +408,26 @@ gtd_task_list_item__render_thumbnail (GtdTaskListItem *item)
            * If we reach the last visible row, it should draw a
            * "…" mark and stop drawing anything else
            */
-          if (y + (padding.top + font_height + padding.bottom) + margin.bottom > 174)
+          if (y + (data->padding.top + font_height + data->padding.bottom) + data->margin.bottom > 174)
             {
               pango_layout_set_text (layout,
                                      "…",
                                      -1);
 
-              gtk_render_layout (context,
-                             cr,
-                             x,
-                             y,
-                             layout);
+              cairo_move_to (cr, x, y);
+              pango_cairo_show_layout (cr, layout);
+
+              data->full = TRUE;
               break;
             }
 
-          gtk_render_layout (context,
-                             cr,
-                             x,
-                             y,
-                             layout);
+          cairo_move_to (cr, x, y);
+          pango_cairo_show_layout (cr, layout);
 
-          y += font_height + padding.bottom;
-        }
+          data->n_rows++;
 
-      g_list_free (tasks);
+          y += font_height + data->padding.bottom;
+        }
     }
   else
     {
@@ -228,51 +448,399 @@ gtd_task_list_item__render_thumbnail (GtdTaskListItem *item)
 
       y = (192 - font_height) / 2.0;
 
-      gtk_render_layout (context,
-                         cr,
-                         33.0 + margin.left,
-                         y,
-                         layout);
+      cairo_move_to (cr, 33.0 + data->margin.left, y);
+      pango_cairo_show_layout (cr, layout);
     }
 
-  pango_font_description_free (font_desc);
   g_object_unref (layout);
+  cairo_destroy (cr);
 
-  /* Retrieves the pixbuf from the drawed image */
-  pix = gdk_pixbuf_get_from_surface (surface,
-                                     0,
-                                     0,
-                                     THUMBNAIL_SIZE,
-                                     THUMBNAIL_SIZE);
+  return surface;
+}
 
-  gdk_rgba_free (color);
+static void
+gtd_task_list_item__render_thread (GTask        *task,
+                                   gpointer      source_object,
+                                   gpointer      task_data,
+                                   GCancellable *cancellable)
+{
+  cairo_surface_t *surface;
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  surface = gtd_task_list_item__render_thumbnail (task_data);
+
+  gtd_task_list_item__save_thumbnail (task_data, surface);
+
+  g_task_return_pointer (task, surface, (GDestroyNotify) cairo_surface_destroy);
+}
+
+/*
+ * Shows a thumbnail loaded from the cache, which may have been
+ * rendered at any scale factor.
+ */
+static void
+gtd_task_list_item__set_thumbnail_pixbuf (GtdTaskListItem *item,
+                                          GdkPixbuf       *pix)
+{
+  cairo_surface_t *surface;
+  gint scale;
+
+  scale = MAX (gdk_pixbuf_get_width (pix) / THUMBNAIL_SIZE, 1);
+  surface = gdk_cairo_surface_create_from_pixbuf (pix, scale, NULL);
+
+  gtk_image_set_from_surface (item->priv->icon_image, surface);
 
-out:
-  gtk_style_context_restore (context);
   cairo_surface_destroy (surface);
-  cairo_destroy (cr);
-  return pix;
 }
 
 static void
-gtd_task_list_item__update_thumbnail (GtdTaskListItem *item)
+gtd_task_list_item__thumbnail_rendered (GObject      *source_object,
+                                        GAsyncResult *result,
+                                        gpointer      user_data)
 {
+  GtdTaskListItem *item = GTD_TASK_LIST_ITEM (source_object);
   GtdTaskListItemPrivate *priv = item->priv;
+  cairo_surface_t *surface;
+  ThumbnailData *data;
+  GError *error = NULL;
 
-  if (!gtd_object_get_ready (GTD_OBJECT (priv->list)))
+  surface = g_task_propagate_pointer (G_TASK (result), &error);
+
+  /* A newer render replaced this one */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+      g_error_free (error);
+      return;
+    }
+
+  g_clear_object (&priv->thumbnail_cancellable);
+
+  if (error)
     {
-      gtk_image_set_from_icon_name (GTK_IMAGE (priv->icon_image),
-                                    "folder-documents-symbolic",
-                                    GTK_ICON_SIZE_DIALOG);
+      g_warning ("%s: %s: %s", G_STRFUNC, _("Error rendering thumbnail"), error->message);
+      g_clear_pointer (&priv->thumbnail_hash, g_free);
+      g_error_free (error);
+      return;
     }
+
+  /*
+   * Only the tasks that fit were drawn. The others are kept, since
+   * changing the one that brought the "…" mark changes the thumbnail.
+   */
+  data = g_task_get_task_data (G_TASK (result));
+
+  priv->thumbnail_rows = MIN (data->n_rows, priv->thumbnail_tasks->len);
+  priv->thumbnail_full = data->full;
+
+  /* The surface has the scale factor of the item, so it's shown as is */
+  gtk_image_set_from_surface (priv->icon_image, surface);
+
+  cairo_surface_destroy (surface);
+}
+
+static void
+gtd_task_list_item__load_thread (GTask        *task,
+                                 gpointer      source_object,
+                                 gpointer      task_data,
+                                 GCancellable *cancellable)
+{
+  GdkPixbuf *pix;
+  GError *error = NULL;
+
+  pix = gdk_pixbuf_new_from_file (task_data, &error);
+
+  if (error)
+    g_task_return_error (task, error);
   else
+    g_task_return_pointer (task, pix, g_object_unref);
+}
+
+static void
+gtd_task_list_item__cached_thumbnail_loaded (GObject      *source_object,
+                                             GAsyncResult *result,
+                                             gpointer      user_data)
+{
+  GtdTaskListItem *item = GTD_TASK_LIST_ITEM (source_object);
+  GtdTaskListItemPrivate *priv = item->priv;
+  GdkPixbuf *pix;
+  GError *error = NULL;
+
+  pix = g_task_propagate_pointer (G_TASK (result), &error);
+
+  /* A render started before the cached thumbnail was loaded */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
     {
-      GdkPixbuf *pix = gtd_task_list_item__render_thumbnail (item);
+      g_error_free (error);
+      return;
+    }
 
-      gtk_image_set_from_pixbuf (GTK_IMAGE (priv->icon_image), pix);
+  g_clear_object (&priv->thumbnail_cancellable);
+
+  /* Nothing cached yet, or the cache is unreadable */
+  if (error)
+    {
+      g_debug ("%s: %s", G_STRFUNC, error->message);
+      g_error_free (error);
+      return;
+    }
 
+  if (!gdk_pixbuf_get_option (pix, HASH_OPTION))
+    {
       g_object_unref (pix);
+      return;
+    }
+
+  /* Show it until the list is loaded and tells whether it's still valid */
+  priv->cached_thumbnail = pix;
+
+  gtd_task_list_item__set_thumbnail_pixbuf (item, pix);
+}
+
+static void
+gtd_task_list_item__load_cached_thumbnail (GtdTaskListItem *item)
+{
+  GtdTaskListItemPrivate *priv = item->priv;
+  GTask *task;
+
+  priv->thumbnail_cancellable = g_cancellable_new ();
+
+  task = g_task_new (item,
+                     priv->thumbnail_cancellable,
+                     gtd_task_list_item__cached_thumbnail_loaded,
+                     NULL);
+
+  g_task_set_task_data (task, gtd_task_list_item__get_cache_path (priv->list), g_free);
+  g_task_run_in_thread (task, gtd_task_list_item__load_thread);
+
+  g_object_unref (task);
+}
+
+/*
+ * Takes a snapshot of the list, its first tasks and the style of the
+ * .thumbnail class, and renders it in a worker thread. The result is
+ * set on the main thread, unless another render was started since.
+ */
+static void
+gtd_task_list_item__update_thumbnail (GtdTaskListItem *item)
+{
+  GtdTaskListItemPrivate *priv = item->priv;
+  GtkStyleContext *context;
+  cairo_surface_t *background;
+  ThumbnailData *data;
+  GtkStateFlags state;
+  PangoLayout *layout;
+  GdkRGBA *color;
+  GTask *task;
+  GList *tasks;
+  GList *l;
+  guint i;
+
+  if (!priv->list)
+    return;
+
+  /* The cached thumbnail, if any, is shown until the list is ready */
+  if (!gtd_object_get_ready (GTD_OBJECT (priv->list)))
+    {
+      if (!priv->cached_thumbnail)
+        {
+          gtk_image_set_from_icon_name (GTK_IMAGE (priv->icon_image),
+                                        "folder-documents-symbolic",
+                                        GTK_ICON_SIZE_DIALOG);
+        }
+
+      return;
+    }
+
+  background = gtd_task_list_item__get_background (THUMBNAIL_SIZE, gtk_widget_get_scale_factor (GTK_WIDGET (item)));
+
+  if (!background)
+    return;
+
+  data = g_new0 (ThumbnailData, 1);
+  data->scale = gtk_widget_get_scale_factor (GTK_WIDGET (item));
+  data->path = gtd_task_list_item__get_cache_path (priv->list);
+  data->background = cairo_surface_reference (background);
+
+  color = gtd_task_list_get_color (priv->list);
+  data->color = *color;
+  gdk_rgba_free (color);
+
+  context = gtk_widget_get_style_context (GTK_WIDGET (item));
+  state = gtk_widget_get_state_flags (GTK_WIDGET (item));
+
+  gtk_style_context_save (context);
+  gtk_style_context_add_class (context, "thumbnail");
+
+  gtk_style_context_get (context,
+                         state,
+                         "font", &data->font_desc,
+                         NULL);
+  gtk_style_context_get_margin (context,
+                                state,
+                                &data->margin);
+  gtk_style_context_get_padding (context,
+                                 state,
+                                 &data->padding);
+  gtk_style_context_get_color (context,
+                               state,
+                               &data->text_color);
+
+  gtk_style_context_restore (context);
+
+  /*
+   * Only the first undone tasks, in the order the user will see when
+   * selecting the list, are needed: the ones that fit in the thumbnail,
+   * plus one more to know whether the "…" mark should be drawn.
+   */
+  layout = gtk_widget_create_pango_layout (GTK_WIDGET (item), NULL);
+  pango_layout_set_font_description (layout, data->font_desc);
+
+  tasks = gtd_task_list_get_first_tasks (priv->list,
+                                         gtd_task_list_item__get_n_rows (layout, &data->margin, &data->padding) + 1);
+
+  g_object_unref (layout);
+
+  data->titles = g_new0 (gchar*, g_list_length (tasks) + 1);
+
+  for (l = tasks, i = 0; l != NULL; l = l->next, i++)
+    data->titles[i] = g_strdup (gtd_task_get_title (l->data));
+
+  data->hash = gtd_task_list_item__compute_hash (data);
+
+  /* The same thumbnail is already shown, or being rendered */
+  if (g_strcmp0 (data->hash, priv->thumbnail_hash) == 0)
+    {
+      thumbnail_data_free (data);
+      g_list_free (tasks);
+      return;
+    }
+
+  g_ptr_array_set_size (priv->thumbnail_tasks, 0);
+  priv->thumbnail_rows = 0;
+  priv->thumbnail_full = FALSE;
+  priv->thumbnail_manual_order = gtd_task_list_get_manual_order (priv->list);
+
+  for (l = tasks; l != NULL; l = l->next)
+    g_ptr_array_add (priv->thumbnail_tasks, g_object_ref (l->data));
+
+  g_list_free (tasks);
+
+  if (priv->thumbnail_cancellable)
+    {
+      g_cancellable_cancel (priv->thumbnail_cancellable);
+      g_clear_object (&priv->thumbnail_cancellable);
+    }
+
+  g_free (priv->thumbnail_hash);
+  priv->thumbnail_hash = g_strdup (data->hash);
+
+  /* The thumbnail cached on disk is still valid */
+  if (priv->cached_thumbnail &&
+      g_strcmp0 (data->hash, gdk_pixbuf_get_option (priv->cached_thumbnail, HASH_OPTION)) == 0)
+    {
+      const gchar *rows = gdk_pixbuf_get_option (priv->cached_thumbnail, ROWS_OPTION);
+      const gchar *full = gdk_pixbuf_get_option (priv->cached_thumbnail, FULL_OPTION);
+
+      priv->thumbnail_rows = MIN (rows ? g_ascii_strtoull (rows, NULL, 10) : 0,
+                                  priv->thumbnail_tasks->len);
+      priv->thumbnail_full = g_strcmp0 (full, "1") == 0;
+
+      gtd_task_list_item__set_thumbnail_pixbuf (item, priv->cached_thumbnail);
+
+      g_clear_object (&priv->cached_thumbnail);
+      thumbnail_data_free (data);
+      return;
+    }
+
+  g_clear_object (&priv->cached_thumbnail);
+
+  /* Render it */
+  priv->thumbnail_cancellable = g_cancellable_new ();
+
+  task = g_task_new (item,
+                     priv->thumbnail_cancellable,
+                     gtd_task_list_item__thumbnail_rendered,
+                     NULL);
+
+  g_task_set_task_data (task, data, (GDestroyNotify) thumbnail_data_free);
+  g_task_run_in_thread (task, gtd_task_list_item__render_thread);
+
+  g_object_unref (task);
+}
+
+static gboolean
+gtd_task_list_item__thumbnail_tick_cb (GtkWidget     *widget,
+                                       GdkFrameClock *frame_clock,
+                                       gpointer       user_data)
+{
+  GtdTaskListItem *item = GTD_TASK_LIST_ITEM (widget);
+
+  item->priv->thumbnail_tick_id = 0;
+  item->priv->thumbnail_dirty = FALSE;
+
+  gtd_task_list_item__update_thumbnail (item);
+
+  return G_SOURCE_REMOVE;
+}
+
+/*
+ * Marks the thumbnail as dirty. It is rendered at most once per
+ * frame, and only when the item is in or near the visible area;
+ * otherwise, it's rendered when the item is scrolled into view.
+ */
+static void
+gtd_task_list_item__queue_thumbnail_update (GtdTaskListItem *item)
+{
+  GtdTaskListItemPrivate *priv = item->priv;
+
+  priv->thumbnail_dirty = TRUE;
+
+  if (!priv->thumbnail_visible)
+    return;
+
+  if (priv->thumbnail_tick_id == 0)
+    {
+      priv->thumbnail_tick_id = gtk_widget_add_tick_callback (GTK_WIDGET (item),
+                                                              gtd_task_list_item__thumbnail_tick_cb,
+                                                              NULL,
+                                                              NULL);
+    }
+}
+
+/*
+ * Whether a change to @task can change the first rows drawn in the
+ * thumbnail: either @task is drawn there or is the one after them, or
+ * it's an undone task that sorts before the last drawn one, or there's
+ * still room for it.
+ */
+static gboolean
+gtd_task_list_item__task_is_visible (GtdTaskListItem *item,
+                                     GtdTask         *task)
+{
+  GtdTaskListItemPrivate *priv = item->priv;
+  GtdTask *last_task;
+  guint i;
+
+  for (i = 0; i < priv->thumbnail_tasks->len; i++)
+    {
+      if (g_ptr_array_index (priv->thumbnail_tasks, i) == task)
+        return TRUE;
     }
+
+  if (gtd_task_get_complete (task))
+    return FALSE;
+
+  if (!priv->thumbnail_full || priv->thumbnail_rows == 0)
+    return TRUE;
+
+  last_task = g_ptr_array_index (priv->thumbnail_tasks, priv->thumbnail_rows - 1);
+
+  if (priv->thumbnail_manual_order)
+    return gtd_task_compare_manual (task, last_task) < 0;
+
+  return gtd_task_compare (task, last_task) < 0;
 }
 
 static void
@@ -280,10 +848,72 @@ gtd_task_list_item__task_changed (GtdTaskList *list,
                                   GtdTask     *task,
                                   gpointer     user_data)
 {
+  GtdTaskListItem *item;
+
   g_return_if_fail (GTD_IS_TASK_LIST_ITEM (user_data));
 
-  if (!gtd_task_get_complete (task))
-    gtd_task_list_item__update_thumbnail (GTD_TASK_LIST_ITEM (user_data));
+  item = GTD_TASK_LIST_ITEM (user_data);
+
+  /* The thumbnail is rendered once when the batch finishes */
+  if (gtd_object_get_updating (GTD_OBJECT (list)) || item->priv->thumbnail_dirty)
+    return;
+
+  if (gtd_task_list_item__task_is_visible (item, task))
+    gtd_task_list_item__queue_thumbnail_update (item);
+}
+
+static void
+gtd_task_list_item__update_visibility (GtdTaskListItem *item)
+{
+  GtdTaskListItemPrivate *priv = item->priv;
+  GtkAllocation allocation;
+  GtkWidget *scrolled_window;
+  gboolean visible;
+  gint y;
+
+  scrolled_window = gtk_widget_get_ancestor (GTK_WIDGET (item), GTK_TYPE_SCROLLED_WINDOW);
+
+  if (!scrolled_window || !gtk_widget_get_realized (GTK_WIDGET (item)))
+    {
+      visible = !scrolled_window;
+    }
+  else if (!gtk_widget_translate_coordinates (GTK_WIDGET (item), scrolled_window, 0, 0, NULL, &y))
+    {
+      visible = FALSE;
+    }
+  else
+    {
+      gtk_widget_get_allocation (GTK_WIDGET (item), &allocation);
+
+      visible = y + allocation.height > -VISIBILITY_MARGIN &&
+                y < gtk_widget_get_allocated_height (scrolled_window) + VISIBILITY_MARGIN;
+    }
+
+  if (priv->thumbnail_visible == visible)
+    return;
+
+  priv->thumbnail_visible = visible;
+
+  /* Render what changed while the item was away */
+  if (visible && priv->thumbnail_dirty)
+    gtd_task_list_item__queue_thumbnail_update (item);
+}
+
+static void
+gtd_task_list_item__notify_updating (GtdTaskListItem *item,
+                                     GParamSpec      *pspec,
+                                     gpointer         user_data)
+{
+  if (!gtd_object_get_updating (GTD_OBJECT (item->priv->list)))
+    gtd_task_list_item__queue_thumbnail_update (item);
+}
+
+static void
+gtd_task_list_item__notify_scale_factor (GtdTaskListItem *item,
+                                         GParamSpec      *pspec,
+                                         gpointer         user_data)
+{
+  gtd_task_list_item__queue_thumbnail_update (item);
 }
 
 static void
@@ -291,7 +921,7 @@ gtd_task_list_item__notify_ready (GtdTaskListItem *item,
                                   GParamSpec      *pspec,
                                   gpointer         user_data)
 {
-  gtd_task_list_item__update_thumbnail (item);
+  gtd_task_list_item__queue_thumbnail_update (item);
 }
 
 GtkWidget*
@@ -309,7 +939,110 @@ gtd_task_list_item_state_flags_changed (GtkWidget     *item,
   if (GTK_WIDGET_CLASS (gtd_task_list_item_parent_class)->state_flags_changed)
     GTK_WIDGET_CLASS (gtd_task_list_item_parent_class)->state_flags_changed (item, flags);
 
-  gtd_task_list_item__update_thumbnail (GTD_TASK_LIST_ITEM (item));
+  gtd_task_list_item__queue_thumbnail_update (GTD_TASK_LIST_ITEM (item));
+}
+
+/*
+ * Disconnects the item from its list, and forgets the thumbnail
+ * of the list, so that the item can be reused for another one.
+ */
+static void
+gtd_task_list_item__unbind_list (GtdTaskListItem *item)
+{
+  GtdTaskListItemPrivate *priv = item->priv;
+
+  if (priv->thumbnail_tick_id > 0)
+    {
+      gtk_widget_remove_tick_callback (GTK_WIDGET (item), priv->thumbnail_tick_id);
+      priv->thumbnail_tick_id = 0;
+    }
+
+  if (priv->thumbnail_cancellable)
+    {
+      g_cancellable_cancel (priv->thumbnail_cancellable);
+      g_clear_object (&priv->thumbnail_cancellable);
+    }
+
+  g_slist_free_full (priv->bindings, (GDestroyNotify) g_binding_unbind);
+  priv->bindings = NULL;
+
+  if (priv->list)
+    g_signal_handlers_disconnect_by_data (priv->list, item);
+
+  g_clear_object (&priv->list);
+
+  if (priv->thumbnail_tasks)
+    g_ptr_array_set_size (priv->thumbnail_tasks, 0);
+
+  g_clear_pointer (&priv->thumbnail_hash, g_free);
+  g_clear_object (&priv->cached_thumbnail);
+
+  priv->thumbnail_rows = 0;
+  priv->thumbnail_full = FALSE;
+  priv->thumbnail_dirty = FALSE;
+}
+
+static void
+gtd_task_list_item_size_allocate (GtkWidget     *widget,
+                                  GtkAllocation *allocation)
+{
+  GTK_WIDGET_CLASS (gtd_task_list_item_parent_class)->size_allocate (widget, allocation);
+
+  gtd_task_list_item__update_visibility (GTD_TASK_LIST_ITEM (widget));
+}
+
+static void
+gtd_task_list_item_hierarchy_changed (GtkWidget *widget,
+                                      GtkWidget *previous_toplevel)
+{
+  GtdTaskListItemPrivate *priv = GTD_TASK_LIST_ITEM (widget)->priv;
+  GtkWidget *scrolled_window;
+
+  if (GTK_WIDGET_CLASS (gtd_task_list_item_parent_class)->hierarchy_changed)
+    GTK_WIDGET_CLASS (gtd_task_list_item_parent_class)->hierarchy_changed (widget, previous_toplevel);
+
+  /* Follow the scrolling of the overview */
+  if (priv->vadjustment)
+    {
+      g_signal_handlers_disconnect_by_data (priv->vadjustment, widget);
+      g_clear_object (&priv->vadjustment);
+    }
+
+  scrolled_window = gtk_widget_get_ancestor (widget, GTK_TYPE_SCROLLED_WINDOW);
+
+  if (scrolled_window)
+    {
+      priv->vadjustment = g_object_ref (gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (scrolled_window)));
+
+      g_signal_connect_swapped (priv->vadjustment,
+                                "value-changed",
+                                G_CALLBACK (gtd_task_list_item__update_visibility),
+                                widget);
+      g_signal_connect_swapped (priv->vadjustment,
+                                "changed",
+                                G_CALLBACK (gtd_task_list_item__update_visibility),
+                                widget);
+    }
+
+  gtd_task_list_item__update_visibility (GTD_TASK_LIST_ITEM (widget));
+}
+
+static void
+gtd_task_list_item_dispose (GObject *object)
+{
+  GtdTaskListItem *self = GTD_TASK_LIST_ITEM (object);
+  GtdTaskListItemPrivate *priv = self->priv;
+
+  /* Items can be destroyed before their lists */
+  gtd_task_list_item__unbind_list (self);
+
+  if (priv->vadjustment)
+    {
+      g_signal_handlers_disconnect_by_data (priv->vadjustment, self);
+      g_clear_object (&priv->vadjustment);
+    }
+
+  G_OBJECT_CLASS (gtd_task_list_item_parent_class)->dispose (object);
 }
 
 static void
@@ -318,6 +1051,8 @@ gtd_task_list_item_finalize (GObject *object)
   GtdTaskListItem *self = (GtdTaskListItem *)object;
   GtdTaskListItemPrivate *priv = gtd_task_list_item_get_instance_private (self);
 
+  g_clear_pointer (&priv->thumbnail_tasks, g_ptr_array_unref);
+
   G_OBJECT_CLASS (gtd_task_list_item_parent_class)->finalize (object);
 }
 
@@ -362,53 +1097,7 @@ gtd_task_list_item_set_property (GObject      *object,
       break;
 
     case PROP_TASK_LIST:
-      priv->list = g_value_get_object (value);
-      g_object_bind_property (priv->list,
-                              "name",
-                              priv->title_label,
-                              "label",
-                              G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE);
-
-      g_object_bind_property (priv->list,
-                              "origin",
-                              priv->subtitle_label,
-                              "label",
-                              G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE);
-
-      g_object_bind_property (priv->list,
-                              "ready",
-                              priv->spinner,
-                              "visible",
-                              G_BINDING_DEFAULT | G_BINDING_INVERT_BOOLEAN | G_BINDING_SYNC_CREATE);
-
-      g_object_bind_property (priv->list,
-                              "ready",
-                              priv->spinner,
-                              "active",
-                              G_BINDING_DEFAULT | G_BINDING_INVERT_BOOLEAN | G_BINDING_SYNC_CREATE);
-
-      g_signal_connect_swapped (priv->list,
-                                "notify::ready",
-                                G_CALLBACK (gtd_task_list_item__notify_ready),
-                                self);
-      g_signal_connect (priv->list,
-                       "task-added",
-                        G_CALLBACK (gtd_task_list_item__task_changed),
-                        self);
-      g_signal_connect (priv->list,
-                       "task-removed",
-                        G_CALLBACK (gtd_task_list_item__task_changed),
-                        self);
-      g_signal_connect (priv->list,
-                       "task-updated",
-                        G_CALLBACK (gtd_task_list_item__task_changed),
-                        self);
-
-      g_object_bind_property (priv->spinner,
-                              "visible",
-                              priv->list,
-                              "ready",
-                              G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE);
+      gtd_task_list_item_set_list (self, g_value_get_object (value));
       break;
 
     default:
@@ -422,10 +1111,13 @@ gtd_task_list_item_class_init (GtdTaskListItemClass *klass)
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
+  object_class->dispose = gtd_task_list_item_dispose;
   object_class->finalize = gtd_task_list_item_finalize;
   object_class->get_property = gtd_task_list_item_get_property;
   object_class->set_property = gtd_task_list_item_set_property;
 
+  widget_class->hierarchy_changed = gtd_task_list_item_hierarchy_changed;
+  widget_class->size_allocate = gtd_task_list_item_size_allocate;
   widget_class->state_flags_changed = gtd_task_list_item_state_flags_changed;
 
   /**
@@ -456,7 +1148,7 @@ gtd_task_list_item_class_init (GtdTaskListItemClass *klass)
                              _("Task list of the item"),
                              _("The task list associated with this item"),
                              GTD_TYPE_TASK_LIST,
-                             G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+                             G_PARAM_READWRITE));
 
   /* template class */
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gnome/todo/ui/task-list-item.ui");
@@ -472,8 +1164,15 @@ static void
 gtd_task_list_item_init (GtdTaskListItem *self)
 {
   self->priv = gtd_task_list_item_get_instance_private (self);
+  self->priv->thumbnail_tasks = g_ptr_array_new_with_free_func (g_object_unref);
 
   gtk_widget_init_template (GTK_WIDGET (self));
+
+  /* Thumbnails are rendered at the scale factor of the item */
+  g_signal_connect (self,
+                    "notify::scale-factor",
+                    G_CALLBACK (gtd_task_list_item__notify_scale_factor),
+                    NULL);
 }
 
 /**
@@ -491,3 +1190,91 @@ gtd_task_list_item_get_list (GtdTaskListItem *item)
 
   return item->priv->list;
 }
+
+/**
+ * gtd_task_list_item_set_list:
+ * @item: a #GtdTaskListItem
+ * @list: a #GtdTaskList
+ *
+ * Sets the #GtdTaskList shown by @item. Items can be reused for
+ * other lists, e.g. when the overview is scrolled.
+ *
+ * Returns:
+ */
+void
+gtd_task_list_item_set_list (GtdTaskListItem *item,
+                             GtdTaskList     *list)
+{
+  GtdTaskListItemPrivate *priv;
+
+  g_return_if_fail (GTD_IS_TASK_LIST_ITEM (item));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  priv = item->priv;
+
+  if (priv->list == list)
+    return;
+
+  gtd_task_list_item__unbind_list (item);
+
+  priv->list = g_object_ref (list);
+
+  priv->bindings = g_slist_prepend (priv->bindings,
+                                    g_object_bind_property (list,
+                                                            "name",
+                                                            priv->title_label,
+                                                            "label",
+                                                            G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE));
+
+  priv->bindings = g_slist_prepend (priv->bindings,
+                                    g_object_bind_property (list,
+                                                            "origin",
+                                                            priv->subtitle_label,
+                                                            "label",
+                                                            G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE));
+
+  priv->bindings = g_slist_prepend (priv->bindings,
+                                    g_object_bind_property (list,
+                                                            "ready",
+                                                            priv->spinner,
+                                                            "visible",
+                                                            G_BINDING_DEFAULT | G_BINDING_INVERT_BOOLEAN | G_BINDING_SYNC_CREATE));
+
+  priv->bindings = g_slist_prepend (priv->bindings,
+                                    g_object_bind_property (list,
+                                                            "ready",
+                                                            priv->spinner,
+                                                            "active",
+                                                            G_BINDING_DEFAULT | G_BINDING_INVERT_BOOLEAN | G_BINDING_SYNC_CREATE));
+
+  g_signal_connect_swapped (list,
+                            "notify::ready",
+                            G_CALLBACK (gtd_task_list_item__notify_ready),
+                            item);
+  g_signal_connect_swapped (list,
+                            "notify::updating",
+                            G_CALLBACK (gtd_task_list_item__notify_updating),
+                            item);
+  g_signal_connect (list,
+                    "task-added",
+                    G_CALLBACK (gtd_task_list_item__task_changed),
+                    item);
+  g_signal_connect (list,
+                    "task-removed",
+                    G_CALLBACK (gtd_task_list_item__task_changed),
+                    item);
+  g_signal_connect (list,
+                    "task-updated",
+                    G_CALLBACK (gtd_task_list_item__task_changed),
+                    item);
+
+  /* Show the placeholder until the thumbnail of the new list is ready */
+  gtk_image_set_from_icon_name (priv->icon_image,
+                                "folder-documents-symbolic",
+                                GTK_ICON_SIZE_DIALOG);
+
+  gtd_task_list_item__load_cached_thumbnail (item);
+  gtd_task_list_item__queue_thumbnail_update (item);
+
+  g_object_notify (G_OBJECT (item), "task-list");
+}
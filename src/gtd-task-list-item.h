@@ -33,6 +33,9 @@ GtkWidget*              gtd_task_list_item_new                (GtdTaskList
 
 GtdTaskList*            gtd_task_list_item_get_list           (GtdTaskListItem      *item);
 
+void                    gtd_task_list_item_set_list           (GtdTaskListItem      *item,
+                                                               GtdTaskList          *list);
+
 G_END_DECLS
 
 #endif /* GTD_TASK_LIST_ITEM_H */
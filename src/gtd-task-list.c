@@ -59,6 +59,70 @@ enum
   LAST_PROP
 };
 
+/*
+ * Restores the max-heap order of @heap, i.e. the task that sorts last
+ * is at the root, after the root was replaced.
+ */
+static void
+gtd_task_list__heap_sift_down (GPtrArray    *heap,
+                               GCompareFunc  compare)
+{
+  guint index = 0;
+
+  while (2 * index + 1 < heap->len)
+    {
+      guint child = 2 * index + 1;
+      gpointer tmp;
+
+      if (child + 1 < heap->len &&
+          compare (g_ptr_array_index (heap, child + 1), g_ptr_array_index (heap, child)) > 0)
+        {
+          child++;
+        }
+
+      if (compare (g_ptr_array_index (heap, index), g_ptr_array_index (heap, child)) >= 0)
+        break;
+
+      tmp = heap->pdata[index];
+      heap->pdata[index] = heap->pdata[child];
+      heap->pdata[child] = tmp;
+
+      index = child;
+    }
+}
+
+static void
+gtd_task_list__heap_sift_up (GPtrArray    *heap,
+                             GCompareFunc  compare)
+{
+  guint index = heap->len - 1;
+
+  while (index > 0)
+    {
+      guint parent = (index - 1) / 2;
+      gpointer tmp;
+
+      if (compare (g_ptr_array_index (heap, parent), g_ptr_array_index (heap, index)) >= 0)
+        break;
+
+      tmp = heap->pdata[index];
+      heap->pdata[index] = heap->pdata[parent];
+      heap->pdata[parent] = tmp;
+
+      index = parent;
+    }
+}
+
+static gint
+gtd_task_list__compare_tasks (gconstpointer a,
+                              gconstpointer b,
+                              gpointer      user_data)
+{
+  GCompareFunc compare = user_data;
+
+  return compare (*((GtdTask**) a), *((GtdTask**) b));
+}
+
 static void
 gtd_task_list_finalize (GObject *object)
 {
@@ -379,6 +443,98 @@ gtd_task_list_get_tasks (GtdTaskList *list)
   return g_list_copy (list->priv->tasks);
 }
 
+/**
+ * gtd_task_list_get_manual_order:
+ * @list: a #GtdTaskList
+ *
+ * Checks whether @list was manually ordered, i.e. whether any of its
+ * tasks has a position. Such lists are shown in the order of the
+ * positions.
+ *
+ * Returns: %TRUE if @list is manually ordered, %FALSE otherwise
+ */
+gboolean
+gtd_task_list_get_manual_order (GtdTaskList *list)
+{
+  GList *l;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST (list), FALSE);
+
+  for (l = list->priv->tasks; l != NULL; l = l->next)
+    {
+      if (gtd_task_get_position (l->data))
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/**
+ * gtd_task_list_get_first_tasks:
+ * @list: a #GtdTaskList
+ * @n_tasks: the maximum number of tasks to retrieve
+ *
+ * Retrieves the first @n_tasks undone tasks of @list, in the order
+ * the list is shown: sorted with gtd_task_compare_manual() if @list
+ * is manually ordered, and with gtd_task_compare() otherwise. Only
+ * @n_tasks tasks are kept while going through the list, so this is
+ * much cheaper than sorting all the tasks when @n_tasks is small.
+ *
+ * Returns: (element-type GtdTask) (transfer container): a newly-allocated
+ * list of at most @n_tasks undone tasks. Free with @g_list_free after use.
+ */
+GList*
+gtd_task_list_get_first_tasks (GtdTaskList *list,
+                               guint        n_tasks)
+{
+  GCompareFunc compare;
+  GPtrArray *heap;
+  GList *tasks;
+  GList *l;
+  guint i;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST (list), NULL);
+
+  if (n_tasks == 0)
+    return NULL;
+
+  if (gtd_task_list_get_manual_order (list))
+    compare = (GCompareFunc) gtd_task_compare_manual;
+  else
+    compare = (GCompareFunc) gtd_task_compare;
+
+  /* A max-heap of the best tasks so far, with the worst one at the root */
+  heap = g_ptr_array_sized_new (n_tasks);
+
+  for (l = list->priv->tasks; l != NULL; l = l->next)
+    {
+      if (gtd_task_get_complete (l->data))
+        continue;
+
+      if (heap->len < n_tasks)
+        {
+          g_ptr_array_add (heap, l->data);
+          gtd_task_list__heap_sift_up (heap, compare);
+        }
+      else if (compare (l->data, g_ptr_array_index (heap, 0)) < 0)
+        {
+          heap->pdata[0] = l->data;
+          gtd_task_list__heap_sift_down (heap, compare);
+        }
+    }
+
+  g_ptr_array_sort_with_data (heap, gtd_task_list__compare_tasks, compare);
+
+  tasks = NULL;
+
+  for (i = heap->len; i > 0; i--)
+    tasks = g_list_prepend (tasks, g_ptr_array_index (heap, i - 1));
+
+  g_ptr_array_unref (heap);
+
+  return tasks;
+}
+
 /**
  * gtd_task_list_save_task:
  * @list: a #GtdTaskList
@@ -431,6 +587,47 @@ gtd_task_list_remove_task (GtdTaskList *list,
   g_signal_emit (list, signals[TASK_REMOVED], 0, task);
 }
 
+/**
+ * gtd_task_list_remove_completed_tasks:
+ * @list: a #GtdTaskList
+ *
+ * Removes all the completed tasks of @list, and drops the references
+ * @list holds to them. Tasks with operations still running, i.e. that
+ * aren't ready, are kept. This is a single pass over @list, much
+ * cheaper than calling gtd_task_list_remove_task() for each task.
+ *
+ * Returns:
+ */
+void
+gtd_task_list_remove_completed_tasks (GtdTaskList *list)
+{
+  GList *removed;
+  GList *l;
+
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
+
+  removed = NULL;
+  l = list->priv->tasks;
+
+  while (l != NULL)
+    {
+      GList *next = l->next;
+
+      if (gtd_task_get_complete (l->data) && gtd_object_get_ready (l->data))
+        {
+          list->priv->tasks = g_list_remove_link (list->priv->tasks, l);
+          removed = g_list_concat (l, removed);
+        }
+
+      l = next;
+    }
+
+  for (l = removed; l != NULL; l = l->next)
+    g_signal_emit (list, signals[TASK_REMOVED], 0, l->data);
+
+  g_list_free_full (removed, g_object_unref);
+}
+
 /**
  * gtd_task_list_contains:
  * @list: a #GtdTaskList
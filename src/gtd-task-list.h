@@ -47,12 +47,19 @@ void                    gtd_task_list_set_name                  (GtdTaskList
 
 GList*                  gtd_task_list_get_tasks                 (GtdTaskList            *list);
 
+gboolean                gtd_task_list_get_manual_order          (GtdTaskList            *list);
+
+GList*                  gtd_task_list_get_first_tasks           (GtdTaskList            *list,
+                                                                 guint                   n_tasks);
+
 void                    gtd_task_list_save_task                 (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
 void                    gtd_task_list_remove_task               (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
+void                    gtd_task_list_remove_completed_tasks    (GtdTaskList            *list);
+
 gboolean                gtd_task_list_contains                  (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
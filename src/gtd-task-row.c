@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "gtd-day-clock.h"
 #include "gtd-task-row.h"
 #include "gtd-task.h"
 #include "gtd-task-list.h"
@@ -40,6 +41,11 @@ typedef struct
   GtkSpinner                *task_loading_spinner;
   GtkLabel                  *title_label;
 
+  /* task bindings */
+  GBinding                  *complete_binding;
+  GBinding                  *date_binding;
+  GBinding                  *ready_binding;
+
   /* data */
   gboolean                   new_task_mode;
   GtdTask                   *task;
@@ -78,57 +84,29 @@ gtd_task_row__date_changed_binding (GBinding     *binding,
                                     GValue       *to_value,
                                     gpointer      user_data)
 {
-  GtdTaskRowPrivate *priv;
-  GDateTime *dt;
-  gchar *new_label = NULL;
-
   g_return_val_if_fail (GTD_IS_TASK_ROW (user_data), FALSE);
 
-  priv = GTD_TASK_ROW (user_data)->priv;
-  dt = g_value_get_boxed (from_value);
+  g_value_set_string (to_value, gtd_day_clock_format_date (gtd_day_clock_get_default (),
+                                                           g_value_get_boxed (from_value)));
 
-  if (dt)
-    {
-      GDateTime *today = g_date_time_new_now_local ();
-      new_label = g_date_time_format (dt, "%x");
+  return TRUE;
+}
 
-      if (g_date_time_get_year (dt) == g_date_time_get_year (today) &&
-          g_date_time_get_month (dt) == g_date_time_get_month (today))
-        {
-          if (g_date_time_get_day_of_month (dt) == g_date_time_get_day_of_month (today))
-            {
-              new_label = g_strdup (_("Today"));
-            }
-          else if (g_date_time_get_day_of_month (dt) == g_date_time_get_day_of_month (today) + 1)
-            {
-              new_label = g_strdup (_("Tomorrow"));
-            }
-          else if (g_date_time_get_day_of_month (dt) == g_date_time_get_day_of_month (today) - 1)
-            {
-              new_label = g_strdup (_("Yesterday"));
-            }
-          else if (g_date_time_get_day_of_year (dt) > g_date_time_get_day_of_month (today) &&
-                   g_date_time_get_day_of_year (dt) < g_date_time_get_day_of_month (today) + 7)
-            {
-              new_label = g_date_time_format (dt, "%A");
-            }
-          else
-            {
-              new_label = g_date_time_format (dt, "%x");
-            }
-        }
+static void
+gtd_task_row__day_changed (GtdTaskRow *row)
+{
+  GtdTaskRowPrivate *priv = row->priv;
+  GDateTime *dt;
 
-    }
-  else
-    {
-      new_label = g_strdup (_("No date set"));
-    }
+  if (!priv->task)
+    return;
 
-  g_value_set_string (to_value, new_label);
+  /* "Today", "Tomorrow" and friends are relative to the current day */
+  dt = gtd_task_get_due_date (priv->task);
 
-  g_free (new_label);
+  gtk_label_set_label (priv->task_date_label, gtd_day_clock_format_date (gtd_day_clock_get_default (), dt));
 
-  return TRUE;
+  g_clear_pointer (&dt, g_date_time_unref);
 }
 
 static GtdTask*
@@ -233,12 +211,25 @@ gtd_task_row__entry_activated (GtkEntry *entry,
     }
 }
 
+static void
+gtd_task_row_dispose (GObject *object)
+{
+  /* The day clock outlives the row, and dispose may run more than once */
+  g_signal_handlers_disconnect_by_func (gtd_day_clock_get_default (),
+                                        gtd_task_row__day_changed,
+                                        object);
+
+  G_OBJECT_CLASS (gtd_task_row_parent_class)->dispose (object);
+}
+
 static void
 gtd_task_row_finalize (GObject *object)
 {
   GtdTaskRow *self = (GtdTaskRow *)object;
   GtdTaskRowPrivate *priv = gtd_task_row_get_instance_private (self);
 
+  g_clear_object (&priv->task);
+
   G_OBJECT_CLASS (gtd_task_row_parent_class)->finalize (object);
 }
 
@@ -303,6 +294,7 @@ gtd_task_row_class_init (GtdTaskRowClass *klass)
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
   GtkListBoxRowClass *row_class = GTK_LIST_BOX_ROW_CLASS (klass);
 
+  object_class->dispose = gtd_task_row_dispose;
   object_class->finalize = gtd_task_row_finalize;
   object_class->get_property = gtd_task_row_get_property;
   object_class->set_property = gtd_task_row_set_property;
@@ -424,6 +416,11 @@ gtd_task_row_init (GtdTaskRow *self)
   self->priv = gtd_task_row_get_instance_private (self);
 
   gtk_widget_init_template (GTK_WIDGET (self));
+
+  g_signal_connect_swapped (gtd_day_clock_get_default (),
+                            "day-changed",
+                            G_CALLBACK (gtd_task_row__day_changed),
+                            self);
 }
 
 /**
@@ -465,7 +462,7 @@ gtd_task_row_set_new_task_mode (GtdTaskRow *row,
       if (new_task_mode)
         {
           gtk_stack_set_visible_child_name (GTK_STACK (row->priv->stack), "new");
-          gtd_task_row_reveal (row);
+          gtd_task_row_reveal (row, TRUE);
         }
       else
         {
@@ -499,7 +496,8 @@ gtd_task_row_get_task (GtdTaskRow *row)
  * @task: a #GtdTask
  *
  * Sets the internal #GtdTask of @row. The task must be set to %NULL
- * before setting GtdObject::new-task-mode to %TRUE.
+ * before setting GtdObject::new-task-mode to %TRUE. Rows can be
+ * bound to another task at any time, which allows reusing them.
  *
  * Returns:
  */
@@ -507,37 +505,47 @@ void
 gtd_task_row_set_task (GtdTaskRow *row,
                        GtdTask    *task)
 {
+  GtdTaskRowPrivate *priv;
+
   g_return_if_fail (GTD_IS_TASK_ROW (row));
 
-  if (row->priv->task != task)
+  priv = row->priv;
+
+  if (priv->task != task)
     {
-      row->priv->task = task;
+      /* Drop the bindings with the previous task */
+      g_clear_pointer (&priv->complete_binding, g_binding_unbind);
+      g_clear_pointer (&priv->date_binding, g_binding_unbind);
+      g_clear_pointer (&priv->ready_binding, g_binding_unbind);
+      g_clear_object (&priv->task);
 
       if (task)
         {
-          gtk_entry_set_text (row->priv->title_entry, gtd_task_get_title (task));
-          gtk_label_set_label (row->priv->task_list_label, gtd_task_list_get_name (gtd_task_get_list (task)));
-          g_object_bind_property (task,
-                                  "complete",
-                                  row->priv->done_check,
-                                  "active",
-                                  G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
-
-          g_object_bind_property (task,
-                                  "ready",
-                                  row->priv->task_loading_spinner,
-                                  "visible",
-                                  G_BINDING_INVERT_BOOLEAN | G_BINDING_SYNC_CREATE);
-
-          g_object_bind_property_full (task,
-                                       "due-date",
-                                       row->priv->task_date_label,
-                                       "label",
-                                       G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE,
-                                       gtd_task_row__date_changed_binding,
-                                       NULL,
-                                       row,
-                                       NULL);
+          priv->task = g_object_ref (task);
+
+          gtk_entry_set_text (priv->title_entry, gtd_task_get_title (task));
+          gtk_label_set_label (priv->task_list_label, gtd_task_list_get_name (gtd_task_get_list (task)));
+          priv->complete_binding = g_object_bind_property (task,
+                                                           "complete",
+                                                           priv->done_check,
+                                                           "active",
+                                                           G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+
+          priv->ready_binding = g_object_bind_property (task,
+                                                        "ready",
+                                                        priv->task_loading_spinner,
+                                                        "visible",
+                                                        G_BINDING_INVERT_BOOLEAN | G_BINDING_SYNC_CREATE);
+
+          priv->date_binding = g_object_bind_property_full (task,
+                                                            "due-date",
+                                                            priv->task_date_label,
+                                                            "label",
+                                                            G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE,
+                                                            gtd_task_row__date_changed_binding,
+                                                            NULL,
+                                                            row,
+                                                            NULL);
         }
 
       g_object_notify (G_OBJECT (row), "task");
@@ -565,32 +573,55 @@ gtd_task_row_set_list_name_visible (GtdTaskRow *row,
 /**
  * gtd_task_row_reveal:
  * @row: a #GtdTaskRow
+ * @animated: whether to animate the transition
  *
- * Runs a nifty animation to reveal @row.
+ * Runs a nifty animation to reveal @row. If @animated is %FALSE,
+ * @row is revealed right away.
  *
  * Returns:
  */
 void
-gtd_task_row_reveal (GtdTaskRow *row)
+gtd_task_row_reveal (GtdTaskRow *row,
+                     gboolean    animated)
 {
+  GtkRevealerTransitionType transition_type;
+
   g_return_if_fail (GTD_IS_TASK_ROW (row));
 
+  if (animated)
+    {
+      gtk_revealer_set_reveal_child (row->priv->revealer, TRUE);
+      return;
+    }
+
+  transition_type = gtk_revealer_get_transition_type (row->priv->revealer);
+
+  gtk_revealer_set_transition_type (row->priv->revealer, GTK_REVEALER_TRANSITION_TYPE_NONE);
   gtk_revealer_set_reveal_child (row->priv->revealer, TRUE);
+  gtk_revealer_set_transition_type (row->priv->revealer, transition_type);
 }
 
 /**
  * gtd_task_row_destroy:
  * @row: a #GtdTaskRow
+ * @animated: whether to animate the transition
  *
- * Runs an animation and the destory @row.
+ * Runs an animation and the destory @row. If @animated is %FALSE,
+ * or @row is still being revealed, @row is destroyed right away.
  *
  * Returns:
  */
 void
-gtd_task_row_destroy (GtdTaskRow *row)
+gtd_task_row_destroy (GtdTaskRow *row,
+                      gboolean    animated)
 {
   g_return_if_fail (GTD_IS_TASK_ROW (row));
-  g_return_if_fail (gtk_revealer_get_child_revealed (row->priv->revealer));
+
+  if (!animated || !gtk_revealer_get_child_revealed (row->priv->revealer))
+    {
+      gtk_widget_destroy (GTK_WIDGET (row));
+      return;
+    }
 
   g_signal_connect_swapped (row->priv->revealer,
                             "notify::child-revealed",
@@ -45,9 +45,11 @@ void                      gtd_task_row_set_task                 (GtdTaskRow
 void                      gtd_task_row_set_list_name_visible    (GtdTaskRow          *row,
                                                                  gboolean             show_list_name);
 
-void                      gtd_task_row_reveal                   (GtdTaskRow          *row);
+void                      gtd_task_row_reveal                   (GtdTaskRow          *row,
+                                                                 gboolean             animated);
 
-void                      gtd_task_row_destroy                  (GtdTaskRow          *row);
+void                      gtd_task_row_destroy                  (GtdTaskRow          *row,
+                                                                 gboolean             animated);
 
 G_END_DECLS
 
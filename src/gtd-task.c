@@ -23,6 +23,7 @@
 #include <libecal/libecal.h>
 #include <libical/icaltime.h>
 #include <libical/icaltimezone.h>
+#include <string.h>
 
 typedef struct
 {
@@ -41,6 +42,9 @@ struct _GtdTask
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtdTask, gtd_task, GTD_TYPE_OBJECT)
 
+/* VTODO property holding the manual position of the task */
+#define POSITION_PROPERTY                        "X-GNOME-TODO-POSITION"
+
 enum
 {
   PROP_0,
@@ -49,6 +53,7 @@ enum
   PROP_DESCRIPTION,
   PROP_DUE_DATE,
   PROP_LIST,
+  PROP_POSITION,
   PROP_PRIORITY,
   PROP_TITLE,
   LAST_PROP
@@ -161,6 +166,10 @@ gtd_task_get_property (GObject    *object,
       g_value_set_object (value, self->priv->list);
       break;
 
+    case PROP_POSITION:
+      g_value_set_string (value, gtd_task_get_position (self));
+      break;
+
     case PROP_PRIORITY:
       g_value_set_int (value, gtd_task_get_priority (self));
       break;
@@ -215,6 +224,10 @@ gtd_task_set_property (GObject      *object,
       gtd_task_set_list (self, g_value_get_object (value));
       break;
 
+    case PROP_POSITION:
+      gtd_task_set_position (self, g_value_get_string (value));
+      break;
+
     case PROP_PRIORITY:
       gtd_task_set_priority (self, g_value_get_int (value));
       break;
@@ -313,6 +326,21 @@ gtd_task_class_init (GtdTaskClass *klass)
                              GTD_TYPE_TASK_LIST,
                              G_PARAM_READWRITE));
 
+  /**
+   * GtdTask::position:
+   *
+   * The manual position of the task inside its list, as a
+   * fractional index, or %NULL if not set.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_POSITION,
+        g_param_spec_string ("position",
+                             _("Position of the task"),
+                             _("The position of the task when its list is manually ordered"),
+                             NULL,
+                             G_PARAM_READWRITE));
+
   /**
    * GtdTask::priority:
    *
@@ -693,6 +721,93 @@ gtd_task_set_list (GtdTask     *task,
     }
 }
 
+static icalproperty*
+gtd_task__get_position_property (GtdTask *task)
+{
+  icalcomponent *ical_comp;
+  icalproperty *property;
+
+  ical_comp = e_cal_component_get_icalcomponent (task->priv->component);
+
+  for (property = icalcomponent_get_first_property (ical_comp, ICAL_X_PROPERTY);
+       property != NULL;
+       property = icalcomponent_get_next_property (ical_comp, ICAL_X_PROPERTY))
+    {
+      if (g_strcmp0 (icalproperty_get_x_name (property), POSITION_PROPERTY) == 0)
+        return property;
+    }
+
+  return NULL;
+}
+
+/**
+ * gtd_task_get_position:
+ * @task: a #GtdTask
+ *
+ * Retrieves the manual position of @task inside its list. Positions
+ * are fractional indices, see gtd_fractional_index_between(), and are
+ * compared with strcmp().
+ *
+ * Returns: (transfer none): the position of @task, or %NULL if not set.
+ */
+const gchar*
+gtd_task_get_position (GtdTask *task)
+{
+  icalproperty *property;
+
+  g_return_val_if_fail (GTD_IS_TASK (task), NULL);
+
+  property = gtd_task__get_position_property (task);
+
+  return property ? icalproperty_get_x (property) : NULL;
+}
+
+/**
+ * gtd_task_set_position:
+ * @task: a #GtdTask
+ * @position: (nullable): the new position of @task, or %NULL
+ *
+ * Sets the manual position of @task inside its list. Only the
+ * position of @task changes, so moving a task needs no changes
+ * to the other tasks.
+ *
+ * Returns:
+ */
+void
+gtd_task_set_position (GtdTask     *task,
+                       const gchar *position)
+{
+  icalcomponent *ical_comp;
+  icalproperty *property;
+
+  g_return_if_fail (GTD_IS_TASK (task));
+
+  if (g_strcmp0 (gtd_task_get_position (task), position) == 0)
+    return;
+
+  ical_comp = e_cal_component_get_icalcomponent (task->priv->component);
+  property = gtd_task__get_position_property (task);
+
+  if (!position)
+    {
+      icalcomponent_remove_property (ical_comp, property);
+      icalproperty_free (property);
+    }
+  else if (property)
+    {
+      icalproperty_set_x (property, position);
+    }
+  else
+    {
+      property = icalproperty_new_x (position);
+      icalproperty_set_x_name (property, POSITION_PROPERTY);
+
+      icalcomponent_add_property (ical_comp, property);
+    }
+
+  g_object_notify (G_OBJECT (task), "position");
+}
+
 /**
  * gtd_task_get_priority:
  * @task: a #GtdTask
@@ -910,3 +1025,40 @@ gtd_task_compare (GtdTask *t1,
    */
   return g_strcmp0 (gtd_task_get_title (t1), gtd_task_get_title (t2));
 }
+
+/**
+ * gtd_task_compare_manual:
+ * @t1: a #GtdTask
+ * @t2: a #GtdTask
+ *
+ * Compares @t1 and @t2 in the order of a manually ordered list, i.e.
+ * by their positions. Tasks without a position go after the others,
+ * and ties are broken by gtd_task_compare().
+ *
+ * Returns: a negative value if @t1 goes before @t2, a positive value
+ * if it goes after it, and 0 if they are equal.
+ */
+gint
+gtd_task_compare_manual (GtdTask *t1,
+                         GtdTask *t2)
+{
+  const gchar *p1;
+  const gchar *p2;
+
+  p1 = t1 ? gtd_task_get_position (t1) : NULL;
+  p2 = t2 ? gtd_task_get_position (t2) : NULL;
+
+  if (p1 && p2)
+    {
+      gint retval = strcmp (p1, p2);
+
+      if (retval != 0)
+        return retval;
+    }
+  else if (p1 || p2)
+    {
+      return p1 ? -1 : 1;
+    }
+
+  return gtd_task_compare (t1, t2);
+}
@@ -54,6 +54,11 @@ GtdTaskList*        gtd_task_get_list                 (GtdTask              *tas
 void                gtd_task_set_list                 (GtdTask              *task,
                                                        GtdTaskList          *list);
 
+const gchar*        gtd_task_get_position             (GtdTask              *task);
+
+void                gtd_task_set_position             (GtdTask              *task,
+                                                       const gchar          *position);
+
 gint                gtd_task_get_priority             (GtdTask              *task);
 
 void                gtd_task_set_priority             (GtdTask              *task,
@@ -71,6 +76,9 @@ void                gtd_task_save                     (GtdTask              *tas
 gint                gtd_task_compare                  (GtdTask              *t1,
                                                        GtdTask              *t2);
 
+gint                gtd_task_compare_manual           (GtdTask              *t1,
+                                                       GtdTask              *t2);
+
 G_END_DECLS
 
 #endif /* GTD_TASK_H */
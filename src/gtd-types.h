@@ -26,11 +26,14 @@
 G_BEGIN_DECLS
 
 typedef struct _GtdApplication          GtdApplication;
+typedef struct _GtdDayClock             GtdDayClock;
 typedef struct _GtdListView             GtdListView;
 typedef struct _GtdManager              GtdManager;
 typedef struct _GtdObject               GtdObject;
 typedef struct _GtdTask                 GtdTask;
+typedef struct _GtdTaskAggregate        GtdTaskAggregate;
 typedef struct _GtdTaskList             GtdTaskList;
+typedef struct _GtdTaskListGrid         GtdTaskListGrid;
 typedef struct _GtdTaskListItem         GtdTaskListItem;
 typedef struct _GtdTaskRow              GtdTaskRow;
 typedef struct _GtdWindow               GtdWindow;
@@ -19,8 +19,9 @@
 #include "gtd-application.h"
 #include "gtd-list-view.h"
 #include "gtd-manager.h"
+#include "gtd-task-aggregate.h"
 #include "gtd-task-list.h"
-#include "gtd-task-list-item.h"
+#include "gtd-task-list-grid.h"
 #include "gtd-window.h"
 
 #include <glib/gi18n.h>
@@ -30,15 +31,27 @@ typedef struct
   GtkButton                     *back_button;
   GtkColorButton                *color_button;
   GtkHeaderBar                  *headerbar;
-  GtkFlowBox                    *lists_flowbox;
+  GtdTaskListGrid               *lists_grid;
   GtkStack                      *main_stack;
   GtkButton                     *notification_action_button;
   GtkLabel                      *notification_label;
   GtkRevealer                   *notification_revealer;
   GtkSpinner                    *notification_spinner;
+  GtkToggleButton               *select_button;
   GtkStackSwitcher              *stack_switcher;
+  GtkStack                      *list_views_stack;
+  GtdListView                   *all_list_view;
+
+  /* the tasks of all lists, shown by all_list_view */
+  GtdTaskAggregate              *aggregate;
+
+  /* the visible list view */
   GtdListView                   *list_view;
 
+  /* recently used list views, most recent first */
+  GQueue                        *cached_list_views;
+  guint                          hibernate_timeout_id;
+
   /* mode */
   GtdWindowMode                  mode;
 
@@ -79,6 +92,21 @@ typedef struct
 
 #define LOADING_LISTS_NOTIFICATION_ID            "loading-lists-id"
 
+/*
+ * Recently viewed lists keep their populated GtdListView, so going
+ * back to them is instant. The cache is bounded by the number of
+ * views and by the number of tasks they hold.
+ */
+#define MAX_CACHED_LIST_VIEWS                    5
+#define MAX_CACHED_TASKS                         5000
+
+/*
+ * Views not shown for a while are dropped too, and so are the completed
+ * tasks of lists without a view. They're fetched again when needed.
+ */
+#define HIBERNATE_INTERVAL                       60
+#define HIBERNATE_DELAY                          (10 * 60)
+
 static gboolean      gtd_window__execute_notification_data       (NotificationData      *data);
 
 
@@ -196,7 +224,7 @@ gtd_window__list_color_set (GtkColorChooser *button,
   GdkRGBA new_color;
 
   g_return_if_fail (GTD_IS_WINDOW (user_data));
-  g_return_if_fail (gtd_list_view_get_task_list (priv->list_view));
+  g_return_if_fail (priv->list_view && gtd_list_view_get_task_list (priv->list_view));
 
   list = gtd_list_view_get_task_list (priv->list_view);
 
@@ -211,26 +239,6 @@ gtd_window__list_color_set (GtkColorChooser *button,
   gtd_manager_save_task_list (priv->manager, list);
 }
 
-static gint
-gtd_window__listbox_sort_func (GtdTaskListItem *a,
-                               GtdTaskListItem *b,
-                               gpointer         user_data)
-{
-  GtdTaskList *l1;
-  GtdTaskList *l2;
-  gint retval = 0;
-
-  l1 = gtd_task_list_item_get_list (a);
-  l2 = gtd_task_list_item_get_list (b);
-
-  retval = g_strcmp0 (gtd_task_list_get_origin (l1), gtd_task_list_get_origin (l2));
-
-  if (retval != 0)
-    return retval;
-
-  return g_strcmp0 (gtd_task_list_get_name (l1), gtd_task_list_get_name (l2));
-}
-
 static void
 gtd_window__manager_ready_changed (GObject    *source,
                                    GParamSpec *spec,
@@ -265,6 +273,9 @@ gtd_window__back_button_clicked (GtkButton *button,
 
   g_return_if_fail (GTD_IS_WINDOW (user_data));
 
+  gtk_toggle_button_set_active (priv->select_button, FALSE);
+  gtk_widget_hide (GTK_WIDGET (priv->select_button));
+
   gtk_stack_set_visible_child_name (priv->main_stack, "overview");
   gtk_header_bar_set_custom_title (priv->headerbar, GTK_WIDGET (priv->stack_switcher));
   gtk_widget_hide (GTK_WIDGET (priv->back_button));
@@ -272,18 +283,257 @@ gtd_window__back_button_clicked (GtkButton *button,
 }
 
 static void
-gtd_window__list_selected (GtkFlowBox      *flowbox,
-                           GtdTaskListItem *item,
-                           gpointer         user_data)
+gtd_window__select_button_toggled (GtkToggleButton *button,
+                                   gpointer         user_data)
 {
   GtdWindowPrivate *priv = GTD_WINDOW (user_data)->priv;
+  GtkStyleContext *context;
+  gboolean active;
+
+  g_return_if_fail (GTD_IS_WINDOW (user_data));
+
+  active = gtk_toggle_button_get_active (button);
+  context = gtk_widget_get_style_context (GTK_WIDGET (priv->headerbar));
+
+  priv->mode = active ? GTD_WINDOW_MODE_SELECTION : GTD_WINDOW_MODE_NORMAL;
+
+  if (active)
+    gtk_style_context_add_class (context, "selection-mode");
+  else
+    gtk_style_context_remove_class (context, "selection-mode");
+
+  if (priv->list_view)
+    gtd_list_view_set_selection_mode (priv->list_view, active);
+}
+
+static guint
+gtd_window__count_tasks (GtdListView *view)
+{
+  GList *tasks;
+  guint n_tasks;
+
+  tasks = gtd_task_list_get_tasks (gtd_list_view_get_task_list (view));
+  n_tasks = g_list_length (tasks);
+
+  g_list_free (tasks);
+
+  return n_tasks;
+}
+
+static gint
+gtd_window__get_time (void)
+{
+  return g_get_monotonic_time () / G_USEC_PER_SEC;
+}
+
+/*
+ * Whether the "All" view may be showing or editing the completed tasks
+ * of any list, so none of them can be unloaded.
+ */
+static gboolean
+gtd_window__all_view_needs_lists (GtdWindow *window)
+{
+  GtdWindowPrivate *priv = window->priv;
+
+  /* all_list_view is in the overview's stack, mapped only when on screen */
+  return gtd_list_view_get_show_completed (priv->all_list_view) ||
+         gtk_widget_get_mapped (GTK_WIDGET (priv->all_list_view));
+}
+
+static void
+gtd_window__drop_list_view (GtdWindow   *window,
+                            GtdListView *view)
+{
   GtdTaskList *list;
+
+  list = gtd_list_view_get_task_list (view);
+
+  g_debug ("%s: evicting view of list '%s'",
+           G_STRFUNC,
+           gtd_task_list_get_name (list));
+
+  gtk_widget_destroy (GTK_WIDGET (view));
+
+  /* Nothing else shows the list's completed tasks */
+  if (!gtd_window__all_view_needs_lists (window))
+    gtd_manager_unload_task_list (window->priv->manager, list);
+}
+
+static void
+gtd_window__evict_list_views (GtdWindow *window)
+{
+  GtdWindowPrivate *priv = window->priv;
+  GList *l;
+  guint n_tasks;
+
+  n_tasks = 0;
+
+  for (l = priv->cached_list_views->head; l != NULL; l = l->next)
+    n_tasks += gtd_window__count_tasks (l->data);
+
+  /* The most recently used view is never evicted */
+  while (g_queue_get_length (priv->cached_list_views) > 1 &&
+         (g_queue_get_length (priv->cached_list_views) > MAX_CACHED_LIST_VIEWS ||
+          n_tasks > MAX_CACHED_TASKS))
+    {
+      GtdListView *view;
+
+      view = g_queue_pop_tail (priv->cached_list_views);
+      n_tasks -= gtd_window__count_tasks (view);
+
+      gtd_window__drop_list_view (window, view);
+    }
+}
+
+static gboolean
+gtd_window__hibernate_cb (gpointer user_data)
+{
+  GtdWindow *window = GTD_WINDOW (user_data);
+  GtdWindowPrivate *priv = window->priv;
+  GList *lists;
+  GList *l;
+  gint64 load_time;
+  gint now;
+
+  now = gtd_window__get_time ();
+
+  /* The oldest views are at the tail, and the visible one is never dropped */
+  while (g_queue_get_length (priv->cached_list_views) > 1)
+    {
+      GtdListView *view = g_queue_peek_tail (priv->cached_list_views);
+      gint last_viewed;
+
+      last_viewed = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (view), "last-viewed"));
+
+      if (view == priv->list_view || now - last_viewed < HIBERNATE_DELAY)
+        break;
+
+      g_queue_pop_tail (priv->cached_list_views);
+      gtd_window__drop_list_view (window, view);
+    }
+
+  if (gtd_window__all_view_needs_lists (window))
+    return G_SOURCE_CONTINUE;
+
+  lists = gtd_manager_get_task_lists (priv->manager);
+
+  for (l = lists; l != NULL; l = l->next)
+    {
+      GList *v;
+
+      for (v = priv->cached_list_views->head; v != NULL; v = v->next)
+        {
+          if (gtd_list_view_get_task_list (v->data) == l->data)
+            break;
+        }
+
+      if (v)
+        continue;
+
+      /* Give prefetched lists time to be opened */
+      load_time = gtd_manager_get_task_list_load_time (priv->manager, l->data);
+
+      if (load_time > 0 && g_get_monotonic_time () - load_time >= HIBERNATE_DELAY * G_USEC_PER_SEC)
+        gtd_manager_unload_task_list (priv->manager, l->data);
+    }
+
+  g_list_free (lists);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static GtdListView*
+gtd_window__get_list_view (GtdWindow   *window,
+                           GtdTaskList *list)
+{
+  GtdWindowPrivate *priv = window->priv;
+  GtkWidget *view;
+  GList *l;
+
+  for (l = priv->cached_list_views->head; l != NULL; l = l->next)
+    {
+      if (gtd_list_view_get_task_list (l->data) != list)
+        continue;
+
+      /* Move to the front of the cache */
+      g_queue_unlink (priv->cached_list_views, l);
+      g_queue_push_head_link (priv->cached_list_views, l);
+
+      g_object_set_data (G_OBJECT (l->data), "last-viewed", GINT_TO_POINTER (gtd_window__get_time ()));
+
+      return l->data;
+    }
+
+  /* Not cached, build a new view */
+  view = gtd_list_view_new ();
+  gtd_list_view_set_manager (GTD_LIST_VIEW (view), priv->manager);
+  gtd_list_view_set_readonly (GTD_LIST_VIEW (view), FALSE);
+  gtd_list_view_set_task_list (GTD_LIST_VIEW (view), list);
+  gtk_widget_show (view);
+
+  g_object_set_data (G_OBJECT (view), "last-viewed", GINT_TO_POINTER (gtd_window__get_time ()));
+
+  gtk_container_add (GTK_CONTAINER (priv->list_views_stack), view);
+
+  g_queue_push_head (priv->cached_list_views, view);
+
+  gtd_window__evict_list_views (window);
+
+  return GTD_LIST_VIEW (view);
+}
+
+static void
+gtd_window__list_removed (GtdManager  *manager,
+                          GtdTaskList *list,
+                          gpointer     user_data)
+{
+  GtdWindowPrivate *priv = GTD_WINDOW (user_data)->priv;
+  GList *l;
+
+  gtd_task_aggregate_remove_list (priv->aggregate, list);
+  gtd_task_list_grid_remove_list (priv->lists_grid, list);
+
+  for (l = priv->cached_list_views->head; l != NULL; l = l->next)
+    {
+      GtdListView *view = l->data;
+
+      if (gtd_list_view_get_task_list (view) != list)
+        continue;
+
+      if (view == priv->list_view)
+        {
+          gtd_window__back_button_clicked (NULL, user_data);
+          priv->list_view = NULL;
+        }
+
+      g_queue_delete_link (priv->cached_list_views, l);
+      gtk_widget_destroy (GTK_WIDGET (view));
+      break;
+    }
+}
+
+static void
+gtd_window__list_hovered (GtdTaskListGrid *grid,
+                          GtdTaskList     *list,
+                          gpointer         user_data)
+{
+  GtdWindowPrivate *priv = GTD_WINDOW (user_data)->priv;
+
+  /* Prefetch the tasks of the list the user is about to open */
+  gtd_manager_load_task_list (priv->manager, list);
+}
+
+static void
+gtd_window__list_selected (GtdTaskListGrid *grid,
+                           GtdTaskList     *list,
+                           gpointer         user_data)
+{
+  GtdWindowPrivate *priv = GTD_WINDOW (user_data)->priv;
   GdkRGBA *list_color;
 
   g_return_if_fail (GTD_IS_WINDOW (user_data));
-  g_return_if_fail (GTD_IS_TASK_LIST_ITEM (item));
+  g_return_if_fail (GTD_IS_TASK_LIST (list));
 
-  list = gtd_task_list_item_get_list (item);
   list_color = gtd_task_list_get_color (list);
 
   g_signal_handlers_block_by_func (priv->color_button,
@@ -296,10 +546,12 @@ gtd_window__list_selected (GtkFlowBox      *flowbox,
   gtk_header_bar_set_title (priv->headerbar, gtd_task_list_get_name (list));
   gtk_header_bar_set_subtitle (priv->headerbar, gtd_task_list_get_origin (list));
   gtk_header_bar_set_custom_title (priv->headerbar, NULL);
-  gtd_list_view_set_task_list (priv->list_view, list);
+  priv->list_view = gtd_window__get_list_view (GTD_WINDOW (user_data), list);
+  gtk_stack_set_visible_child (priv->list_views_stack, GTK_WIDGET (priv->list_view));
   gtd_list_view_set_show_completed (priv->list_view, FALSE);
   gtk_widget_show (GTK_WIDGET (priv->back_button));
   gtk_widget_show (GTK_WIDGET (priv->color_button));
+  gtk_widget_show (GTK_WIDGET (priv->select_button));
 
   g_signal_handlers_unblock_by_func (priv->color_button,
                                      gtd_window__list_color_set,
@@ -314,27 +566,9 @@ gtd_window__list_added (GtdManager  *manager,
                         gpointer     user_data)
 {
   GtdWindowPrivate *priv = GTD_WINDOW (user_data)->priv;
-  GtkWidget *item;
-
-  item = gtd_task_list_item_new (list);
-  gtk_widget_show (item);
-
-  gtk_flow_box_insert (priv->lists_flowbox,
-                       item,
-                       -1);
-}
-
-static void
-gtd_window_constructed (GObject *object)
-{
-  GtdWindowPrivate *priv = GTD_WINDOW (object)->priv;
-
-  G_OBJECT_CLASS (gtd_window_parent_class)->constructed (object);
 
-  gtk_flow_box_set_sort_func (priv->lists_flowbox,
-                              (GtkFlowBoxSortFunc) gtd_window__listbox_sort_func,
-                              NULL,
-                              NULL);
+  gtd_task_aggregate_add_list (priv->aggregate, list);
+  gtd_task_list_grid_add_list (priv->lists_grid, list);
 }
 
 GtkWidget*
@@ -349,6 +583,18 @@ gtd_window_new (GtdApplication *application)
 static void
 gtd_window_finalize (GObject *object)
 {
+  GtdWindowPrivate *priv = GTD_WINDOW (object)->priv;
+
+  if (priv->hibernate_timeout_id > 0)
+    {
+      g_source_remove (priv->hibernate_timeout_id);
+      priv->hibernate_timeout_id = 0;
+    }
+
+  /* the views themselves are destroyed with the stack */
+  g_queue_free (priv->cached_list_views);
+  g_clear_object (&priv->aggregate);
+
   G_OBJECT_CLASS (gtd_window_parent_class)->finalize (object);
 }
 
@@ -384,7 +630,7 @@ gtd_window_set_property (GObject      *object,
     case PROP_MANAGER:
       self->priv->manager = g_value_get_object (value);
 
-      gtd_list_view_set_manager (self->priv->list_view, self->priv->manager);
+      gtd_list_view_set_manager (self->priv->all_list_view, self->priv->manager);
 
       g_signal_connect (self->priv->manager,
                         "notify::ready",
@@ -394,6 +640,10 @@ gtd_window_set_property (GObject      *object,
                         "list-added",
                         G_CALLBACK (gtd_window__list_added),
                         self);
+      g_signal_connect (self->priv->manager,
+                        "list-removed",
+                        G_CALLBACK (gtd_window__list_removed),
+                        self);
 
       g_object_notify (object, "manager");
       break;
@@ -410,7 +660,6 @@ gtd_window_class_init (GtdWindowClass *klass)
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
   object_class->finalize = gtd_window_finalize;
-  object_class->constructed = gtd_window_constructed;
   object_class->get_property = gtd_window_get_property;
   object_class->set_property = gtd_window_set_property;
 
@@ -430,22 +679,26 @@ gtd_window_class_init (GtdWindowClass *klass)
 
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gnome/todo/ui/window.ui");
 
+  gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, all_list_view);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, back_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, color_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, headerbar);
-  gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, lists_flowbox);
-  gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, list_view);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, lists_grid);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, list_views_stack);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, main_stack);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, notification_action_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, notification_label);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, notification_revealer);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, notification_spinner);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, select_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtdWindow, stack_switcher);
 
   gtk_widget_class_bind_template_callback (widget_class, gtd_window__back_button_clicked);
   gtk_widget_class_bind_template_callback (widget_class, gtd_window__list_color_set);
+  gtk_widget_class_bind_template_callback (widget_class, gtd_window__list_hovered);
   gtk_widget_class_bind_template_callback (widget_class, gtd_window__list_selected);
   gtk_widget_class_bind_template_callback (widget_class, gtd_window__notification_close_button_clicked);
+  gtk_widget_class_bind_template_callback (widget_class, gtd_window__select_button_toggled);
 }
 
 static void
@@ -454,8 +707,15 @@ gtd_window_init (GtdWindow *self)
   self->priv = gtd_window_get_instance_private (self);
 
   self->priv->notification_queue = g_queue_new ();
+  self->priv->cached_list_views = g_queue_new ();
+  self->priv->aggregate = gtd_task_aggregate_new ();
+  self->priv->hibernate_timeout_id = g_timeout_add_seconds (HIBERNATE_INTERVAL,
+                                                            gtd_window__hibernate_cb,
+                                                            self);
 
   gtk_widget_init_template (GTK_WIDGET (self));
+
+  gtd_list_view_set_aggregate (self->priv->all_list_view, self->priv->aggregate);
 }
 
 /**